@@ -0,0 +1,13 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+
+// ================= 基准共用的小工具 =================
+
+// 单调时钟，单位毫秒
+inline double benchNowMs() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#endif // BENCH_H
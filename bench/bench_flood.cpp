@@ -0,0 +1,74 @@
+#include <cstdio>
+#include <vector>
+#include "bench.h"
+#include "game.h"
+#include "reveal.h"
+
+using namespace std;
+
+// game.cpp 引用的全局变量（定义在 main.cpp）
+int rows, cols, mineCount;
+bool SafeZone;
+uint64_t gameSeed;
+
+// ================= 连锁翻开：迭代 BFS vs 递归 =================
+// 从第一个 0 雷格子开始展开。递归版即改动前的 RevealFrom 去掉绘制，
+// 大空白区会栈溢出，所以只在小棋盘上对照，并确认两者翻开的格子完全相同。
+
+static int recursiveStride;
+
+static void RevealRecursive(uint8_t* cells, int idx) {
+    uint8_t& cell = cells[idx];
+    if (cell & (CELL_REVEALED | CELL_MINE)) return;
+    cell |= CELL_REVEALED;
+    if (cellCount(cell) != 0) return;
+    for (int k = 0; k < 8; k++) RevealRecursive(cells, idx + neighbourOffset(k, recursiveStride));
+}
+
+int main() {
+    struct Case { int rows, cols, mines; bool recursive; };
+    const Case cases[] = { {5000, 5000, 0, false}, {2000, 2000, 200000, false}, {300, 300, 9000, true} };
+
+    bool ok = true;
+    vector<int> revealed;
+    for (const Case& t : cases) {
+        const int stride = boardStride(t.cols);
+        vector<uint8_t> fresh(boardCellCount(t.rows, t.cols));
+        generateMines(-1, -1, t.rows, t.cols, t.mines, fresh.data(), false, 7);
+
+        int start = -1;
+        for (int i = 0; i < t.rows && start < 0; i++) {
+            for (int j = 0; j < t.cols; j++) {
+                int idx = boardIndex(i, j, stride);
+                if (!cellIsMine(fresh[idx]) && cellCount(fresh[idx]) == 0) {
+                    start = idx;
+                    break;
+                }
+            }
+        }
+
+        vector<uint8_t> cells;
+        for (int rep = 0; rep < 2; rep++) {
+            cells = fresh;
+            revealed.clear();
+            double t0 = benchNowMs();
+            int n = revealFlood(cells.data(), stride, start, revealed);
+            double ms = benchNowMs() - t0;
+            printf("%dx%d, %d mines, iterative (%s): %d cells in %.2f ms (%.0f Mcells/s)\n",
+                   t.rows, t.cols, t.mines, rep ? "warm" : "cold", n, ms, n / ms / 1000);
+        }
+
+        if (t.recursive) {
+            vector<uint8_t> other = fresh;
+            recursiveStride = stride;
+            double t0 = benchNowMs();
+            RevealRecursive(other.data(), start);
+            double ms = benchNowMs() - t0;
+            bool same = other == cells;
+            ok = ok && same;
+            printf("%dx%d, %d mines, recursive: %.2f ms, %s\n", t.rows, t.cols, t.mines, ms,
+                   same ? "same cells" : "DIFFERENT CELLS");
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "bench.h"
+#include "game.h"
+#include "rng.h"
+#include "thread_pool.h"
+
+using namespace std;
+
+// game.cpp 引用的全局变量（定义在 main.cpp）
+int rows, cols, mineCount;
+bool SafeZone;
+uint64_t gameSeed;
+
+// ================= 布雷：逐颗重扫 vs 部分 Fisher-Yates =================
+// 参照实现是改动前的算法：每颗雷抽一个名次，再从头扫描找第 k 个空闲格子，O(mineCount * rows * cols)。
+// 两边都带 3x3 安全区、都算好周围雷数，单线程。
+
+static void RescanMines(int r, int c, int R, int C, int M, uint8_t* cells, uint64_t seed) {
+    BoardRng rng;
+    rngInit(rng, seed, R, C, M);
+    const int stride = boardStride(C);
+    memset(cells, 0, boardCellCount(R, C));
+    boardWriteBorder(cells, R, C);
+
+    int zone = 0;
+    for (int i = 0; i < R; i++)
+        for (int j = 0; j < C; j++)
+            zone += abs(i - r) <= 1 && abs(j - c) <= 1;
+
+    for (int placed = 0; placed < M; placed++) {
+        int pick = rngRange(rng, 0, R * C - zone - placed - 1);
+        bool done = false;
+        for (int i = 0; i < R && !done; i++) {
+            for (int j = 0; j < C && !done; j++) {
+                uint8_t& cell = cells[boardIndex(i, j, stride)];
+                if (cellIsMine(cell) || (abs(i - r) <= 1 && abs(j - c) <= 1)) continue;
+                if (pick-- == 0) {
+                    cell = CELL_MINE;
+                    done = true;
+                }
+            }
+        }
+    }
+    for (int i = 0; i < R; i++)
+        for (int j = 0; j < C; j++)
+            updateAdjacentCount(i, j, C, cells);
+}
+
+int main() {
+    struct Size { int rows, cols, mines; bool reference; };
+    const Size sizes[] = { {30, 30, 180, true}, {100, 100, 2000, true}, {300, 300, 18000, true},
+                           {1000, 1000, 200000, false} };
+    parallelSetThreads(1);
+
+    printf("board       mines    rescan       fisher-yates\n");
+    for (const Size& s : sizes) {
+        vector<uint8_t> board(boardCellCount(s.rows, s.cols));
+        const int reps = s.rows * s.cols <= 10000 ? 20 : 1;
+
+        double rescanMs = 0;
+        if (s.reference) {
+            double t = benchNowMs();
+            for (int k = 0; k < reps; k++) RescanMines(s.rows / 2, s.cols / 2, s.rows, s.cols, s.mines, board.data(), k + 1);
+            rescanMs = (benchNowMs() - t) / reps;
+        }
+
+        double t = benchNowMs();
+        for (int k = 0; k < reps; k++) generateMines(s.rows / 2, s.cols / 2, s.rows, s.cols, s.mines, board.data(), true, k + 1);
+        double shuffleMs = (benchNowMs() - t) / reps;
+
+        char size[32];
+        snprintf(size, sizeof(size), "%dx%d", s.rows, s.cols);
+        if (s.reference) {
+            printf("%-11s %-8d %8.2f ms  %8.2f ms\n", size, s.mines, rescanMs, shuffleMs);
+        } else {
+            printf("%-11s %-8d %11s  %8.2f ms\n", size, s.mines, "-", shuffleMs);
+        }
+    }
+    parallelShutdown();
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "bench.h"
+#include "board.h"
+#include "game.h"
+#include "rng.h"
+
+using namespace std;
+
+// game.cpp 引用的全局变量（定义在 main.cpp）
+int rows, cols, mineCount;
+bool SafeZone;
+uint64_t gameSeed;
+
+// ================= 邻格遍历：逐个判断越界 vs 哨兵 + 线性偏移 =================
+// 同一批棋盘各存两份：不带边框的 rows * cols 数组（dr / dc 双重循环加越界判断），
+// 带哨兵的布局（8 个固定偏移，不判断越界）。分别计时连锁翻开全部空白区、
+// 以及对每个格子做一次双击翻开要用的邻格扫描（插旗数 + 雷数）。
+// 两种展开都是递归写法，与改动时一样，只比较邻格的访问方式。
+
+static int R, C;
+static vector<uint8_t> plain;
+static vector<uint8_t> padded;
+static int offsets[8];
+
+static long FloodChecked(int r, int c) {
+    if (r < 0 || r >= R || c < 0 || c >= C) return 0;
+    uint8_t& cell = plain[r * C + c];
+    if (cell & (CELL_REVEALED | CELL_MINE)) return 0;
+    cell |= CELL_REVEALED;
+    long n = 1;
+    if (cellCount(cell) != 0) return n;
+    for (int dr = -1; dr <= 1; dr++)
+        for (int dc = -1; dc <= 1; dc++)
+            if (dr || dc) n += FloodChecked(r + dr, c + dc);
+    return n;
+}
+
+static long FloodSentinel(int idx) {
+    uint8_t& cell = padded[idx];
+    if (cell & (CELL_REVEALED | CELL_MINE)) return 0;
+    cell |= CELL_REVEALED;
+    long n = 1;
+    if (cellCount(cell) != 0) return n;
+    for (int k = 0; k < 8; k++) n += FloodSentinel(idx + offsets[k]);
+    return n;
+}
+
+static int ChordChecked(int r, int c) {
+    int n = 0;
+    for (int dr = -1; dr <= 1; dr++) {
+        for (int dc = -1; dc <= 1; dc++) {
+            int nr = r + dr, nc = c + dc;
+            if ((!dr && !dc) || nr < 0 || nr >= R || nc < 0 || nc >= C) continue;
+            n += cellIsFlagged(plain[nr * C + nc]) + cellIsMine(plain[nr * C + nc]);
+        }
+    }
+    return n;
+}
+
+static int ChordSentinel(int idx) {
+    int n = 0;
+    for (int k = 0; k < 8; k++) {
+        uint8_t cell = padded[idx + offsets[k]];
+        n += cellIsFlagged(cell) + cellIsMine(cell);
+    }
+    return n;
+}
+
+int main() {
+    double floodChecked = 0, floodSentinel = 0, chordChecked = 0, chordSentinel = 0;
+    long cellsChecked = 0, cellsSentinel = 0, sumChecked = 0, sumSentinel = 0;
+
+    // 400 个 60x60 ~ 260x260、雷密度 8% ~ 18% 的棋盘
+    BoardRng rng;
+    rngInit(rng, 5, 1, 1, 1);
+    for (int b = 0; b < 400; b++) {
+        R = 60 + (int)rngBelow(rng, 200);
+        C = 60 + (int)rngBelow(rng, 200);
+        int M = R * C * (8 + (int)rngBelow(rng, 10)) / 100;
+        const int stride = boardStride(C);
+        for (int k = 0; k < 8; k++) offsets[k] = neighbourOffset(k, stride);
+
+        padded.assign(boardCellCount(R, C), 0);
+        generateMines(-1, -1, R, C, M, padded.data(), false, b + 1);
+        plain.assign((size_t)R * C, 0);
+        for (int i = 0; i < R; i++) memcpy(&plain[(size_t)i * C], &padded[boardIndex(i, 0, stride)], C);
+
+        double t = benchNowMs();
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++)
+                if (cellCount(plain[i * C + j]) == 0) cellsChecked += FloodChecked(i, j);
+        floodChecked += benchNowMs() - t;
+
+        t = benchNowMs();
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++)
+                if (cellCount(padded[boardIndex(i, j, stride)]) == 0) cellsSentinel += FloodSentinel(boardIndex(i, j, stride));
+        floodSentinel += benchNowMs() - t;
+
+        t = benchNowMs();
+        for (int rep = 0; rep < 5; rep++)
+            for (int i = 0; i < R; i++)
+                for (int j = 0; j < C; j++) sumChecked += ChordChecked(i, j);
+        chordChecked += benchNowMs() - t;
+
+        t = benchNowMs();
+        for (int rep = 0; rep < 5; rep++)
+            for (int i = 0; i < R; i++)
+                for (int j = 0; j < C; j++) sumSentinel += ChordSentinel(boardIndex(i, j, stride));
+        chordSentinel += benchNowMs() - t;
+    }
+
+    printf("flood every opening: bounds-checked %.1f ms, sentinel %.1f ms (%ld / %ld cells)\n",
+           floodChecked, floodSentinel, cellsChecked, cellsSentinel);
+    printf("chord scan x5:       bounds-checked %.1f ms, sentinel %.1f ms (%ld / %ld)\n",
+           chordChecked, chordSentinel, sumChecked, sumSentinel);
+    return cellsChecked == cellsSentinel && sumChecked == sumSentinel ? 0 : 1;
+}
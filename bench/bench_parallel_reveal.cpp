@@ -0,0 +1,79 @@
+#include <cstdio>
+#include <vector>
+#include "bench.h"
+#include "game.h"
+#include "reveal.h"
+#include "thread_pool.h"
+
+using namespace std;
+
+// game.cpp 引用的全局变量（定义在 main.cpp）
+int rows, cols, mineCount;
+bool SafeZone;
+uint64_t gameSeed;
+
+// ================= 大空白区：逐格 BFS / 8x8 小块 / 逐层并行 =================
+// 从棋盘中央附近的第一个 0 雷格子展开，取 3 次中最快的一次。
+// 逐层并行分别用 1 / 2 / 4 / 8 个线程；每次展开后的格子数组都必须与 revealFlood 的相同。
+// 机器的核数少于线程数时只能看出线程池本身的开销。
+
+enum Method { FLOOD, TILES, PARALLEL };
+
+static const char* METHOD_NAMES[] = { "flood", "tiles", "parallel" };
+
+static bool Run(const vector<uint8_t>& fresh, const vector<uint8_t>& expected, int R, int C, int start,
+                Method method, int threads) {
+    const int stride = boardStride(C);
+    parallelSetThreads(threads);
+    vector<uint8_t> cells;
+    vector<int> revealed;
+    revealed.reserve(fresh.size());
+    double best = 1e30;
+    int n = 0;
+    for (int rep = 0; rep < 3; rep++) {
+        cells = fresh;
+        revealed.clear();
+        double t = benchNowMs();
+        if (method == FLOOD) {
+            n = revealFlood(cells.data(), stride, start, revealed);
+        } else if (method == TILES) {
+            n = revealTiles(cells.data(), R, C, start, revealed);
+        } else {
+            n = revealParallel(cells.data(), stride, start, revealed);
+        }
+        double ms = benchNowMs() - t;
+        if (ms < best) best = ms;
+    }
+    bool same = expected.empty() || cells == expected;
+    printf("  %-8s %d thr: %d cells, best %.0f ms%s\n", METHOD_NAMES[method], threads, n, best,
+           same ? "" : "  CELLS DIFFER FROM revealFlood");
+    return same;
+}
+
+int main() {
+    struct Case { int rows, cols, mines; };
+    const Case cases[] = { {4000, 4000, 800000}, {8000, 8000, 0} };
+
+    printf("%d hardware threads\n", parallelThreads());
+    bool ok = true;
+    for (const Case& t : cases) {
+        const int stride = boardStride(t.cols);
+        vector<uint8_t> fresh(boardCellCount(t.rows, t.cols));
+        generateMines(-1, -1, t.rows, t.cols, t.mines, fresh.data(), false, 1);
+        int start = boardIndex(t.rows / 2, t.cols / 2, stride);
+        while (cellIsMine(fresh[start]) || cellCount(fresh[start]) != 0) start++;
+
+        // revealFlood 的结果作为基准
+        vector<uint8_t> expected = fresh;
+        vector<int> revealed;
+        revealFlood(expected.data(), stride, start, revealed);
+
+        printf("%dx%d, %d mines:\n", t.rows, t.cols, t.mines);
+        ok &= Run(fresh, expected, t.rows, t.cols, start, FLOOD, 1);
+        ok &= Run(fresh, expected, t.rows, t.cols, start, TILES, 1);
+        for (int threads : { 1, 2, 4, 8 }) ok &= Run(fresh, expected, t.rows, t.cols, start, PARALLEL, threads);
+    }
+    parallelSetThreads(0);
+    parallelShutdown();
+    return ok ? 0 : 1;
+}
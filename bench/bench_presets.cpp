@@ -0,0 +1,176 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "bench.h"
+#include "bitboard.h"
+#include "board_fixed.h"
+#include "game.h"
+#include "reveal.h"
+
+using namespace std;
+
+// game.cpp 引用的全局变量（定义在 main.cpp）
+int rows, cols, mineCount;
+bool SafeZone;
+uint64_t gameSeed;
+
+// ================= 预设尺寸：定尺寸内核 vs 通用路径 =================
+// generateMines 对预设尺寸总是走定尺寸内核，这里另写一份通用路径（候选数组 + 位棋盘计数，
+// 缓冲跨调用复用，与 generateMines 对其他尺寸的做法相同）做对照，并先确认两边逐字节相同。
+// 展开与计数也做同样的对照：SquareTopology<FixedGeometry> 上的 topologyReveal / topologyUpdateCount
+// 对运行期行宽的 revealFlood / updateAdjacentCount。展开相差在噪声以内；计数快约 3 ns，
+// 主要省的是 updateAdjacentCount 这次函数调用，而一局只在首次点击挪雷时重算至多 162 格，
+// 所以预设尺寸的展开与计数仍走通用路径，只有布雷用定尺寸内核。
+
+static vector<int> candidates;
+static Bitboard bitboard;
+
+static void DynamicMines(int r, int c, int R, int C, int M, uint8_t* cells, bool safeZone, uint64_t seed) {
+    const int stride = boardStride(C);
+    DynamicGeometry g = {R, C};
+    candidates.resize((size_t)R * C);
+    int from, to;
+    drawMines(g, r, c, M, safeZone, seed, candidates.data(), from, to);
+
+    bitboardInit(bitboard, R, C);
+    for (int k = from; k < to; k++) bitboardSet(bitboard, candidates[k] / stride - 1, candidates[k] % stride - 1);
+    boardWriteBorder(cells, R, C);
+    for (int i = 0; i < R; i++) bitboardRowCounts(bitboard, i, cells + boardIndex(i, 0, stride));
+    for (int k = from; k < to; k++) cells[candidates[k]] = CELL_MINE;
+}
+
+template <int R, int C>
+static bool Run(int M) {
+    const int boards = 200000;
+    vector<uint8_t> fixed(boardCellCount(R, C)), dynamic(boardCellCount(R, C));
+
+    int mismatches = 0;
+    for (int s = 1; s <= 20000; s++) {
+        generateMinesFixed<R, C>(-1, -1, M, fixed.data(), false, s);
+        DynamicMines(-1, -1, R, C, M, dynamic.data(), false, s);
+        mismatches += memcmp(fixed.data(), dynamic.data(), fixed.size()) != 0;
+        generateMinesFixed<R, C>(R / 2, C / 2, M, fixed.data(), true, s);
+        DynamicMines(R / 2, C / 2, R, C, M, dynamic.data(), true, s);
+        mismatches += memcmp(fixed.data(), dynamic.data(), fixed.size()) != 0;
+    }
+
+    unsigned sink = 0;
+    double t = benchNowMs();
+    for (int s = 1; s <= boards; s++) {
+        generateMinesFixed<R, C>(-1, -1, M, fixed.data(), false, s);
+        sink += fixed[2 * R];
+    }
+    double fixedMs = benchNowMs() - t;
+
+    t = benchNowMs();
+    for (int s = 1; s <= boards; s++) {
+        DynamicMines(-1, -1, R, C, M, dynamic.data(), false, s);
+        sink += dynamic[2 * R];
+    }
+    double dynamicMs = benchNowMs() - t;
+
+    printf("%dx%d, %d mines: fixed %.0f ns, dynamic %.0f ns per board (%.2fx), %d mismatches [%u]\n",
+           R, C, M, fixedMs * 1e6 / boards, dynamicMs * 1e6 / boards, dynamicMs / fixedMs, mismatches, sink & 1);
+    return mismatches == 0;
+}
+
+// 每块棋盘从每个格子各展开一次，展开后只清掉这次翻开的格子，两边的额外开销相同
+template <int R, int C>
+static bool RunReveal(int M) {
+    const int boards = 2000;
+    FixedGeometry<R, C> g;
+    SquareTopology<FixedGeometry<R, C> > square = {g};
+    Board<R, C> board;
+    vector<uint8_t> copy(g.cellCount());
+    vector<int> a, b;
+    a.reserve(R * C);
+    b.reserve(R * C);
+
+    int mismatches = 0;
+    double fixedMs = 0, dynamicMs = 0;
+    long long opened = 0;
+    for (int s = 1; s <= boards; s++) {
+        generateMinesFixed(board, -1, -1, M, false, s);
+        memcpy(copy.data(), board.cells.data(), copy.size());
+
+        double t = benchNowMs();
+        for (int i = 0; i < R * C; i++) {
+            a.clear();
+            opened += topologyReveal(square, board.cells.data(), boardIndex(i / C, i % C, g.stride()), a);
+            for (size_t k = 0; k < a.size(); k++) board.cells[a[k]] &= ~CELL_REVEALED;
+        }
+        fixedMs += benchNowMs() - t;
+
+        t = benchNowMs();
+        for (int i = 0; i < R * C; i++) {
+            b.clear();
+            revealFlood(copy.data(), g.stride(), boardIndex(i / C, i % C, g.stride()), b);
+            for (size_t k = 0; k < b.size(); k++) copy[b[k]] &= ~CELL_REVEALED;
+        }
+        dynamicMs += benchNowMs() - t;
+
+        // 同一格子两边翻开同样的列表
+        for (int i = 0; i < R * C; i += 7) {
+            a.clear();
+            b.clear();
+            topologyReveal(square, board.cells.data(), boardIndex(i / C, i % C, g.stride()), a);
+            revealFlood(copy.data(), g.stride(), boardIndex(i / C, i % C, g.stride()), b);
+            mismatches += a != b || memcmp(board.cells.data(), copy.data(), copy.size()) != 0;
+            for (size_t k = 0; k < a.size(); k++) board.cells[a[k]] &= ~CELL_REVEALED;
+            for (size_t k = 0; k < b.size(); k++) copy[b[k]] &= ~CELL_REVEALED;
+        }
+    }
+
+    const double reveals = (double)boards * R * C;
+    printf("%dx%d, %d mines: reveal fixed %.1f ns, dynamic %.1f ns per click (%.2fx), %d mismatches [%lld]\n",
+           R, C, M, fixedMs * 1e6 / reveals, dynamicMs * 1e6 / reveals, dynamicMs / fixedMs, mismatches, opened & 1);
+    return mismatches == 0;
+}
+
+// 每块棋盘把所有格子的计数各重算一次（relocateMines 挪雷后就是这样逐格修正的）
+template <int R, int C>
+static bool RunCount(int M) {
+    const int boards = 20000;
+    FixedGeometry<R, C> g;
+    SquareTopology<FixedGeometry<R, C> > square = {g};
+    Board<R, C> board;
+    vector<uint8_t> copy(g.cellCount());
+
+    int mismatches = 0;
+    double fixedMs = 0, dynamicMs = 0;
+    for (int s = 1; s <= boards; s++) {
+        generateMinesFixed(board, -1, -1, M, false, s);
+        memcpy(copy.data(), board.cells.data(), copy.size());
+
+        double t = benchNowMs();
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++) topologyUpdateCount(square, board.cells.data(), boardIndex(i, j, g.stride()));
+        fixedMs += benchNowMs() - t;
+
+        t = benchNowMs();
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++) updateAdjacentCount(i, j, C, copy.data());
+        dynamicMs += benchNowMs() - t;
+
+        mismatches += memcmp(board.cells.data(), copy.data(), copy.size()) != 0;
+    }
+
+    const double counts = (double)boards * R * C;
+    printf("%dx%d, %d mines: count fixed %.2f ns, dynamic %.2f ns per cell (%.2fx), %d mismatches\n",
+           R, C, M, fixedMs * 1e6 / counts, dynamicMs * 1e6 / counts, dynamicMs / fixedMs, mismatches);
+    return mismatches == 0;
+}
+
+int main() {
+    bool ok = true;
+    ok &= Run<6, 6>(6);
+    ok &= Run<9, 16>(20);
+    ok &= Run<12, 30>(80);
+    ok &= RunReveal<6, 6>(6);
+    ok &= RunReveal<9, 16>(20);
+    ok &= RunReveal<12, 30>(80);
+    ok &= RunCount<6, 6>(6);
+    ok &= RunCount<9, 16>(20);
+    ok &= RunCount<12, 30>(80);
+    return ok ? 0 : 1;
+}
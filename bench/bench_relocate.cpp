@@ -0,0 +1,45 @@
+#include <cstdio>
+#include <vector>
+#include "bench.h"
+#include "game.h"
+
+using namespace std;
+
+// game.cpp 引用的全局变量（定义在 main.cpp）
+int rows, cols, mineCount;
+bool SafeZone;
+uint64_t gameSeed;
+
+// ================= 首次点击挪雷 vs 整盘重新生成 =================
+// 2000x2000，点击正中。只统计安全区里确实有雷的种子。
+
+static void run(int R, int C, int M, int games, bool regenerate) {
+    vector<uint8_t> board(boardCellCount(R, C));
+    const int r = R / 2, c = C / 2;
+    double relocateMs = 0, regenerateMs = 0;
+    int n = 0;
+    for (uint64_t seed = 1; n < games; seed++) {
+        generateMines(-1, -1, R, C, M, board.data(), false, seed);
+        if (boardFitsFirstClick(board.data(), r, c, R, C, M, true)) continue;
+
+        double t = benchNowMs();
+        relocateMines(r, c, R, C, M, board.data(), true, seed);
+        relocateMs += benchNowMs() - t;
+
+        if (regenerate) {
+            t = benchNowMs();
+            generateMines(r, c, R, C, M, board.data(), true, seed);
+            regenerateMs += benchNowMs() - t;
+        }
+        n++;
+    }
+    printf("%dx%d, %d mines: relocate %.4f ms", R, C, M, relocateMs / n);
+    if (regenerate) printf(", full regenerate %.1f ms", regenerateMs / n);
+    printf("  (mean of %d)\n", n);
+}
+
+int main() {
+    run(2000, 2000, 400000, 20, true);
+    run(2000, 2000, 3999000, 5, false);  // 区外几乎布满，走线性扫描
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include <cstdio>
+#include <vector>
+#include "bench.h"
+#include "game.h"
+#include "thread_pool.h"
+
+using namespace std;
+
+// game.cpp 引用的全局变量（定义在 main.cpp）
+int rows, cols, mineCount;
+bool SafeZone;
+uint64_t gameSeed;
+
+// ================= 按行分块布雷的线程扩展 =================
+// 10000x10000 的棋盘分别用 1 / 2 / 4 / 8 个线程生成，取 3 次中最快的一次。
+// 同一种子的结果与线程数无关，每次都与单线程的结果比对。
+// 机器的核数少于线程数时只能看出线程池本身的开销。
+
+static uint64_t HashCells(const vector<uint8_t>& cells) {
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < cells.size(); i++) h = (h ^ cells[i]) * 1099511628211ull;
+    return h;
+}
+
+int main() {
+    const int R = 10000, C = 10000;
+    const int mineCounts[] = { 1000000, 15000000 };
+    vector<uint8_t> cells(boardCellCount(R, C));
+
+    printf("%d hardware threads\n", parallelThreads());
+    bool ok = true;
+    for (int mines : mineCounts) {
+        uint64_t expected = 0;
+        for (int threads : { 1, 2, 4, 8 }) {
+            parallelSetThreads(threads);
+            double best = 1e30;
+            for (int rep = 0; rep < 3; rep++) {
+                double t = benchNowMs();
+                generateMines(R / 2, C / 2, R, C, mines, cells.data(), true, rep + 1);
+                double ms = benchNowMs() - t;
+                if (ms < best) best = ms;
+            }
+            uint64_t hash = HashCells(cells);
+            if (threads == 1) expected = hash;
+            ok = ok && hash == expected;
+            printf("%dx%d, %d mines, %d threads: best %.0f ms%s\n", R, C, mines, threads, best,
+                   hash == expected ? "" : "  BOARD DIFFERS FROM 1 THREAD");
+        }
+    }
+    parallelSetThreads(0);
+    parallelShutdown();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+#include <cstdio>
+#include <vector>
+#include "bench.h"
+#include "game.h"
+#include "reveal.h"
+
+using namespace std;
+
+// game.cpp 引用的全局变量（定义在 main.cpp）
+int rows, cols, mineCount;
+bool SafeZone;
+uint64_t gameSeed;
+
+// ================= 8x8 小块展开 vs 逐格 BFS =================
+// 尺寸从 256x256 一直到远超 L2（8000x8000 的格子数组 64 MB），跨过 REVEAL_TILE_MIN_CELLS，
+// 密度从全空到接近空白区断开的程度。从棋盘中央附近的第一个 0 雷格子展开，取 3 次中最快的一次；
+// 每次展开后两边的格子数组必须相同。
+
+// 返回最快一次的毫秒数，cells 留下最后一次展开的结果
+static double Best(const vector<uint8_t>& fresh, vector<uint8_t>& cells, vector<int>& revealed,
+                   int R, int C, int start, bool tiles, int& n) {
+    double best = 1e30;
+    for (int rep = 0; rep < 3; rep++) {
+        cells = fresh;
+        revealed.clear();
+        double t = benchNowMs();
+        if (tiles) {
+            n = revealTiles(cells.data(), R, C, start, revealed);
+        } else {
+            n = revealFlood(cells.data(), boardStride(C), start, revealed);
+        }
+        double ms = benchNowMs() - t;
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+int main() {
+    const int sizes[] = { 256, 512, 1000, 2000, 4000, 8000 };
+    const int densities[] = { 0, 5, 10, 14 };  // 百分比
+
+    printf("board       cells   density  opened      flood        tiles       flood / tiles\n");
+    bool ok = true;
+    for (int size : sizes) {
+        for (int density : densities) {
+            const int R = size, C = size, M = (int)((long long)R * C * density / 100);
+            const int stride = boardStride(C);
+            vector<uint8_t> fresh(boardCellCount(R, C));
+            generateMines(-1, -1, R, C, M, fresh.data(), false, 1);
+            int start = boardIndex(R / 2, C / 2, stride);
+            while (cellIsMine(fresh[start]) || cellCount(fresh[start]) != 0) start++;
+
+            vector<uint8_t> floodCells, tileCells;
+            vector<int> revealed;
+            revealed.reserve((size_t)R * C);
+            int floodN = 0, tileN = 0;
+            double floodMs = Best(fresh, floodCells, revealed, R, C, start, false, floodN);
+            double tileMs = Best(fresh, tileCells, revealed, R, C, start, true, tileN);
+            bool same = floodN == tileN && floodCells == tileCells;
+            ok = ok && same;
+
+            char board[32];
+            snprintf(board, sizeof(board), "%dx%d", R, C);
+            printf("%-11s %-7s %3d%%     %-10d %8.2f ms  %8.2f ms  %5.2fx%s\n", board,
+                   fresh.size() >= REVEAL_TILE_MIN_CELLS ? ">= min" : "< min", density, floodN,
+                   floodMs, tileMs, floodMs / tileMs, same ? "" : "  CELLS DIFFER");
+        }
+    }
+    return ok ? 0 : 1;
+}
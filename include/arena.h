@@ -0,0 +1,37 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ================= 单块内存的线性分配器 =================
+// 一局游戏的缓冲（目前只有格子数组）都从同一块内存里顺序切出，
+// 整局结束时不逐个释放；下一局 arenaReset 后从头复用，尺寸不变就不再分配。
+struct Arena {
+    uint8_t* block;
+    size_t capacity;
+    size_t used;
+};
+
+// 清空并保证至少有 bytes 字节可用；容量不够时才重新分配一次
+void arenaReset(Arena& arena, size_t bytes);
+
+// 切出 bytes 字节，起始地址按 align 对齐。空间不足时返回 NULL，
+// 调用方应在 arenaReset 时把对齐补白一起算进去
+void* arenaAlloc(Arena& arena, size_t bytes, size_t align);
+
+template <class T>
+T* arenaAllocArray(Arena& arena, size_t count) {
+    return static_cast<T*>(arenaAlloc(arena, count * sizeof(T), alignof(T)));
+}
+
+// 归还整块内存
+void arenaRelease(Arena& arena);
+
+#ifdef MINESWEEPER_COUNT_ALLOCS
+// 测试钩子：编译时定义 MINESWEEPER_COUNT_ALLOCS 后替换全局 operator new，
+// 返回进程启动以来的堆分配次数，用来确认连续对局时没有新的分配
+size_t allocationCount();
+#endif
+
+#endif // ARENA_H
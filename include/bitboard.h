@@ -0,0 +1,69 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+// ================= 位棋盘：每行雷分布压成若干个 64 位字 =================
+// 第 r 行第 c 列对应 bits 中第 (r + 1) 行、第 1 + c / 64 个字的第 c % 64 位。
+// 上下各补一行全零、每行左右各补一个全零字，邻格移位时不必判断边界。
+struct Bitboard {
+    int rows;
+    int cols;
+    int words;                  // 每行的字数（含左右补零字）
+    std::vector<uint64_t> bits; // (rows + 2) * words
+};
+
+// 按尺寸分配并清零
+void bitboardInit(Bitboard& bb, int rows, int cols);
+
+inline uint64_t* bitboardRow(Bitboard& bb, int r) {
+    return bb.bits.data() + (size_t)(r + 1) * bb.words;
+}
+
+inline const uint64_t* bitboardRow(const Bitboard& bb, int r) {
+    return bb.bits.data() + (size_t)(r + 1) * bb.words;
+}
+
+inline void bitboardSet(Bitboard& bb, int r, int c) {
+    bitboardRow(bb, r)[1 + (c >> 6)] |= (uint64_t)1 << (c & 63);
+}
+
+inline bool bitboardTest(const Bitboard& bb, int r, int c) {
+    return (bitboardRow(bb, r)[1 + (c >> 6)] >> (c & 63)) & 1;
+}
+
+// 64 位字中最低位 1 的位置 (bits != 0)
+inline int bitboardLowestBit(uint64_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return (int)index;
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+// 按列号从小到大，把第 r 行每颗雷的列号交给 visit(c)
+template <class Visit>
+void bitboardForEachInRow(const Bitboard& bb, int r, Visit visit) {
+    const uint64_t* row = bitboardRow(bb, r);
+    for (int w = 1; w < bb.words - 1; w++) {
+        uint64_t bits = row[w];
+        while (bits) {
+            visit((w - 1) * 64 + bitboardLowestBit(bits));
+            bits &= bits - 1;
+        }
+    }
+}
+
+// 计算第 r 行每个格子 3x3 范围内（含自身）的雷数，写入 out[0, cols)。
+// 对非雷格子，这就是它的周围雷数。
+// 用位平面加法（水平三格求和、再竖直三行求和），有 AVX2 / SSE2 时按向量处理。
+void bitboardRowCounts(const Bitboard& bb, int r, uint8_t* out);
+
+#endif // BITBOARD_H
@@ -0,0 +1,49 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include "cell.h"
+
+// ================= 棋盘布局：四周带一圈哨兵格 =================
+// 实际存储 (rows + 2) x (cols + 2) 个格子，第 r 行第 c 列位于 (r + 1) * stride + (c + 1)。
+// 哨兵格 = CELL_BORDER | CELL_REVEALED：不是雷、不能插旗、视为已翻开，
+// 所以遍历 8 个邻格时不需要任何越界判断。
+
+// 8 个邻格的 (行, 列) 偏移，顺序固定
+struct NeighbourDelta {
+    int dr;
+    int dc;
+};
+
+static constexpr NeighbourDelta NEIGHBOURS[8] = {
+    {-1, -1}, {-1, 0}, {-1, 1},
+    { 0, -1},          { 0, 1},
+    { 1, -1}, { 1, 0}, { 1, 1},
+};
+
+constexpr int boardStride(int cols) { return cols + 2; }
+
+constexpr size_t boardCellCount(int rows, int cols) {
+    return (size_t)(rows + 2) * boardStride(cols);
+}
+
+constexpr int boardIndex(int r, int c, int stride) {
+    return (r + 1) * stride + (c + 1);
+}
+
+// 第 k 个邻格相对当前格的线性偏移
+constexpr int neighbourOffset(int k, int stride) {
+    return NEIGHBOURS[k].dr * stride + NEIGHBOURS[k].dc;
+}
+
+// 不带哨兵的 64 位格子坐标，x 为列、y 为行；用于无尽模式和超大稀疏棋盘
+struct WorldPos {
+    int64_t x;
+    int64_t y;
+};
+
+// 写入四周的哨兵格（内部格子不动）
+void boardWriteBorder(uint8_t* cells, int rows, int cols);
+
+#endif // BOARD_H
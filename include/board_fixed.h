@@ -0,0 +1,106 @@
+#ifndef BOARD_FIXED_H
+#define BOARD_FIXED_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "board.h"
+#include "game.h"
+#include "rng.h"
+#include "topology.h"
+
+// ================= 棋盘尺寸：编译期固定 / 运行期给定 =================
+// 两种几何提供同样的接口，下面的内核按几何类型模板化：
+// 预设尺寸用 FixedGeometry，行宽与邻格偏移都是常量，循环可以完全展开；
+// 自定义尺寸用 DynamicGeometry，走同一份代码。
+
+template <int Rows, int Cols>
+struct FixedGeometry {
+    static constexpr int rows() { return Rows; }
+    static constexpr int cols() { return Cols; }
+    static constexpr int stride() { return Cols + 2; }
+    static constexpr size_t cellCount() { return (size_t)(Rows + 2) * (Cols + 2); }
+    static constexpr int neighbour(int k) { return neighbourOffset(k, Cols + 2); }
+};
+
+struct DynamicGeometry {
+    int rowCount;
+    int colCount;
+
+    int rows() const { return rowCount; }
+    int cols() const { return colCount; }
+    int stride() const { return boardStride(colCount); }
+    size_t cellCount() const { return boardCellCount(rowCount, colCount); }
+    int neighbour(int k) const { return neighbourOffset(k, boardStride(colCount)); }
+};
+
+// 定尺寸棋盘：格子直接放在 std::array 里，不做任何堆分配，布局与 board.h 相同
+template <int Rows, int Cols>
+struct Board {
+    typedef FixedGeometry<Rows, Cols> Geometry;
+    std::array<uint8_t, Geometry::cellCount()> cells;
+};
+
+// ================= 按几何模板化的布雷内核 =================
+
+// 一次性构建候选格子集合（排除半径 radius 的受保护格子），存放带哨兵布局下的下标，返回个数
+template <class Geometry>
+int buildCandidates(const Geometry& g, int r, int c, int radius, int* candidates) {
+    int total = 0;
+    for (int i = 0; i < g.rows(); i++) {
+        for (int j = 0; j < g.cols(); j++) {
+            if (abs(i - r) <= radius && abs(j - c) <= radius) continue;
+            candidates[total++] = boardIndex(i, j, g.stride());
+        }
+    }
+    return total;
+}
+
+// 运行期尺寸按行分块并行构建，结果与上面相同
+int buildCandidates(const DynamicGeometry& g, int r, int c, int radius, int* candidates);
+
+// 在 candidates（至少 rows * cols 个 int）上抽雷，[from, to) 为雷格子的下标。
+// 随机数的消耗顺序与尺寸是否固定无关，同一种子两条路径得到同一个棋盘。
+template <class Geometry>
+void drawMines(const Geometry& g, int r, int c, int mineCount, bool SafeZone, uint64_t seed,
+               int* candidates, int& from, int& to) {
+    BoardRng rng;
+    rngInit(rng, seed, g.rows(), g.cols(), mineCount);
+
+    // 判断当前雷数允许哪种级别的保护：半径 1 即 3x3，半径 0 即只保护点击格，-1 不保护
+    int radius = safeZoneRadius(r, c, g.rows(), g.cols(), mineCount, SafeZone);
+
+    int total = buildCandidates(g, r, c, radius, candidates);
+    drawFromCandidates(rng, candidates, total, mineCount, from, to);
+}
+
+// 方格上的 topologyScatterCounts；定尺寸时邻格偏移都是常量
+template <class Geometry>
+void scatterCounts(const Geometry& g, uint8_t* cells, const int* mines, int mineTotal) {
+    SquareTopology<Geometry> t = {g};
+    topologyScatterCounts(t, cells, mines, mineTotal);
+}
+
+// 定尺寸布雷：候选数组在栈上，结果与 generateMines 逐字节相同
+template <int Rows, int Cols>
+void generateMinesFixed(int r, int c, int mineCount, uint8_t* cells, bool SafeZone, uint64_t seed) {
+    FixedGeometry<Rows, Cols> g;
+    std::array<int, Rows * Cols> candidates;
+    int from, to;
+    drawMines(g, r, c, mineCount, SafeZone, seed, candidates.data(), from, to);
+
+    memset(cells, 0, g.cellCount());
+    scatterCounts(g, cells, candidates.data() + from, to - from);
+}
+
+template <int Rows, int Cols>
+void generateMinesFixed(Board<Rows, Cols>& board, int r, int c, int mineCount, bool SafeZone, uint64_t seed) {
+    generateMinesFixed<Rows, Cols>(r, c, mineCount, board.cells.data(), SafeZone, seed);
+}
+
+// 三个预设尺寸 (6x6, 9x16, 12x30) 转到对应的定尺寸内核；其他尺寸返回 false
+bool generatePresetMines(int r, int c, int rows, int cols, int mineCount, uint8_t* cells, bool SafeZone, uint64_t seed);
+
+#endif // BOARD_FIXED_H
@@ -0,0 +1,32 @@
+#ifndef BOARD_POOL_H
+#define BOARD_POOL_H
+
+#include <cstdint>
+
+// ================= 后台预生成棋盘池 =================
+// 后台线程为当前 (rows, cols, mineCount) 预先生成几块不带安全区约束的棋盘，
+// 开局时直接取用，大棋盘也无需等待。
+// 池中棋盘彼此独立、均匀分布；按首次点击筛选出满足安全区的一块，
+// 等价于直接按安全区规则生成（拒绝采样）。
+// 单块棋盘就超过池的内存上限时不预生成，取棋盘总是失败，由调用方当场生成。
+
+struct PooledBoard {
+    uint8_t* cells;     // boardCellCount(rows, cols) 字节，用完交回 boardPoolRecycle
+    uint64_t seed;
+};
+
+// 切换棋盘配置；与当前配置相同时什么也不做。首次调用时启动后台线程
+void boardPoolConfigure(int rows, int cols, int mineCount);
+
+// 取出一块对首次点击 (r, c) 满足安全区规则的棋盘；r < 0 表示不限。
+// 池中暂无合适棋盘时返回 false
+bool boardPoolTake(int r, int c, bool safeZone, PooledBoard& out);
+
+// 交回不再使用的格子缓冲，后台会在上面生成新棋盘。
+// 取走一块后要等它交回，后台才补生成下一块，所以缓冲总数固定，不会另行分配
+void boardPoolRecycle(uint8_t* cells);
+
+// 停止后台线程并释放所有缓冲，程序退出前调用
+void boardPoolShutdown();
+
+#endif // BOARD_POOL_H
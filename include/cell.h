@@ -0,0 +1,23 @@
+#ifndef CELL_H
+#define CELL_H
+
+#include <cstdint>
+
+// ================= 格子状态：每格 1 字节 =================
+// bit 0~3 : 周围雷数 (0~8)，雷格子为 0
+// bit 4   : 是雷
+// bit 5   : 已翻开
+// bit 6   : 已插旗
+// bit 7   : 棋盘外的哨兵格（见 board.h）
+#define CELL_COUNT_MASK 0x0F
+#define CELL_MINE       0x10
+#define CELL_REVEALED   0x20
+#define CELL_FLAG       0x40
+#define CELL_BORDER     0x80
+
+inline int cellCount(uint8_t cell) { return cell & CELL_COUNT_MASK; }
+inline bool cellIsMine(uint8_t cell) { return (cell & CELL_MINE) != 0; }
+inline bool cellIsRevealed(uint8_t cell) { return (cell & CELL_REVEALED) != 0; }
+inline bool cellIsFlagged(uint8_t cell) { return (cell & CELL_FLAG) != 0; }
+
+#endif // CELL_H
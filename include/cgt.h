@@ -99,6 +99,25 @@ bool cgt_has_key();
 void cgt_get_key(char& ch);
 
 
+/**
+ * 把还没显示的输出立即显示到屏幕上。
+ *
+ * Linux / macOS 上 cgt_print_* 只写入帧缓冲，检查键盘鼠标事件和 cgt_msleep 时
+ * 才把与屏幕不同的格子一次写出，所以一般不需要调用本函数。
+ */
+void cgt_present();
+
+/**
+ * 开始 / 结束一帧。
+ *
+ * 两者之间的输出只攒在帧缓冲里，检查事件和 cgt_msleep 也不会把它显示出来；
+ * 最外层的 cgt_end_frame 把整帧一次写出，终端支持同步输出（DEC 2026）时整帧一起刷新，
+ * 一大片翻开或踩雷时的重画不会被看到画了一半。可以嵌套，必须成对调用，帧内不要等待输入。
+ */
+void cgt_begin_frame();
+void cgt_end_frame();
+
+
 void cgt_set_color(int foreground = COLOR_WHITE, int background = COLOR_BLACK);
 void cgt_reset_color();
 
@@ -118,6 +137,21 @@ void cgt_print_str(const char* str, int x = -1, int y = -1, int foreground = COL
 void cgt_print_char(char str, int x = -1, int y = -1, int foreground = COLOR_WHITE, int background = COLOR_BLACK);
 
 
+/**
+ * 从 (x, y) 起向右用 len 个字符 ch 填满一段，颜色为 foreground 和 background。
+ *
+ * 画一整段同色的格线、色块时，比逐个 cgt_print_char 少得多的调用与输出。
+ * 不移动光标，x / y 不能为 -1。
+ */
+void cgt_fill_span(int x, int y, int len, int foreground, int background, char ch = ' ');
+
+
+/**
+ * 用字符 ch 填满左上角在 (x, y)、width 列 x height 行的矩形，颜色为 foreground 和 background。
+ */
+void cgt_fill_rect(int x, int y, int width, int height, int foreground, int background, char ch = ' ');
+
+
 /**
  * 在 (x, y) 位置打印浮点数 value，颜色为 foreground 和 background。
  */
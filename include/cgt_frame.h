@@ -0,0 +1,71 @@
+#ifndef CGT_FRAME_H
+#define CGT_FRAME_H
+
+#include <string>
+#include <vector>
+
+// ================= cgt 的终端帧缓冲（ANSI 后端共用） =================
+// back 为程序想显示的画面，front 为终端上现在的画面，每格一个 (字符, 前景色, 背景色)。
+// cgt_print_* 只写 back；呈现时逐行比较两者，只输出变了的格子：
+// 光标能顺着走就不移动，同一行里向右跳用 CUF，颜色没变就不发 SGR，空格不在乎前景色。
+// 整段输出先攒在一个字符串里，由后端一次 write 写出。
+// 成片同底色的空格（格线、色块）用 ECH 一次擦掉，输出与连续段数成正比、与长度无关。
+// 中文等宽字符占两格：左格存整个字符，右格 len = 0；后端不关心编码，只按 UTF-8 切分。
+// cgt_begin_frame / cgt_end_frame 之间不自动呈现，结束时整帧一次写出；终端支持同步输出
+// （DEC 私有模式 2026）时再用 ?2026h / ?2026l 包起来，终端收齐一帧才刷新，不会画到一半被看见。
+
+// 格子字节数的特殊值：终端上这一格的内容未知，下次呈现一定重画
+#define CGT_CELL_UNKNOWN 255
+// 帧缓冲最多的行数、列数，超出的输出直接丢弃
+#define CGT_FRAME_MAX_SIDE 1024
+// 至少这么多格的同底色空格才用 ECH（ESC [ n X）擦除，再用 CUF 跳过；更短时直接写空格更省
+#define CGT_FRAME_ERASE_MIN 12
+// 询问终端是否支持同步输出（DECRQM，回答形如 ESC [ ? 2026 ; Ps $ y），后面跟一个所有终端都会回答的 DA1，
+// 先收到 DA1 的回答就说明终端不认识 DECRQM，不必干等超时
+#define CGT_SYNC_QUERY "\033[?2026$p\033[c"
+#define CGT_SYNC_BEGIN "\033[?2026h"
+#define CGT_SYNC_END "\033[?2026l"
+
+struct CgtCell {
+    char glyph[4];          // UTF-8 编码的字符
+    unsigned char len;      // glyph 的字节数；0 为宽字符的右半格
+    signed char fg;
+    signed char bg;
+};
+
+struct CgtFrame {
+    int width;
+    int height;
+    std::vector<CgtCell> back;
+    std::vector<CgtCell> front;
+    int blankBg;            // 上次清屏的底色，新长出来的格子按这个颜色算
+    int cursorX;            // cgt_print_* 的当前位置，x / y 为 -1 时从这里接着写
+    int cursorY;
+    int termX;              // 终端光标与颜色，-1 表示不知道
+    int termY;
+    int termFg;
+    int termBg;
+    int screenCols;         // 终端的大小，0 表示不知道；超出的格子不输出
+    int screenRows;
+    bool dirty;             // back 自上次呈现后被写过
+    int depth;              // cgt_begin_frame 的嵌套层数，大于 0 时不自动呈现
+    bool syncOutput;        // 终端支持同步输出
+};
+
+// 清屏之后：两个缓冲都是 bg 色的空白，终端光标在左上角、颜色未知
+void cgt_frame_reset(CgtFrame& f, int bg, int screenCols, int screenRows);
+
+// 从 (x, y) 起写 UTF-8 文本，x / y 为 -1 时接着上次写的位置
+void cgt_frame_put(CgtFrame& f, const char* text, int x, int y, int fg, int bg);
+
+// 用 fg / bg 色的 ASCII 字符 ch 填满从 (x, y) 起 width x height 的矩形，不移动 cgt_print_* 的当前位置
+void cgt_frame_fill(CgtFrame& f, char ch, int x, int y, int width, int height, int fg, int bg);
+
+// 把 back 与 front 的差异编码追加到 out，之后 front 与 back 相同。返回是否追加了内容。
+// sync 为 true 且终端支持时，用同步输出包起来
+bool cgt_frame_present(CgtFrame& f, std::string& out, bool sync = false);
+
+// 在终端的回答 buf 里找 CGT_SYNC_QUERY 的回答：1 支持同步输出，0 不支持，-1 还没收到回答
+int cgt_frame_parse_sync_reply(const char* buf, int len);
+
+#endif // CGT_FRAME_H
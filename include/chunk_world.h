@@ -0,0 +1,90 @@
+#ifndef CHUNK_WORLD_H
+#define CHUNK_WORLD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "board.h"
+
+// ================= 无尽模式：按区块按需生成的无限棋盘 =================
+// 世界被切成 CHUNK_SIZE x CHUNK_SIZE 的区块，格子坐标 (x, y) 可以是任意 64 位整数。
+// 每个区块的雷只由 rngHash(世界种子, 区块坐标) 决定，翻开或展开第一次碰到它时才生成；
+// 周围雷数会读取相邻区块的雷，所以跨区块边界的数字同样正确。
+// 远离活动范围的区块被压缩成“已翻开 / 插旗”两张位图（雷随时可以按种子重新生成），
+// 从未碰过的区块不占内存，完整形式常驻的区块数有上限。
+
+#define CHUNK_SHIFT 6
+#define CHUNK_SIZE (1 << CHUNK_SHIFT)
+#define CHUNK_CELLS (CHUNK_SIZE * CHUNK_SIZE)
+// 每个区块固定的雷数（约 15.6%）。密度低于约 10% 时 0 雷格子会连成无限大的一片
+#define CHUNK_MINES 640
+// 完整形式常驻的区块数上限（每块约 4 KB）
+#define WORLD_MAX_ACTIVE_CHUNKS 256
+// 单次展开最多翻开的格子数，防止一次点击卡住
+#define WORLD_FLOOD_LIMIT (1 << 20)
+// 原点周围这个半径内不放雷，原点必定是一片空白区，开局直接翻开
+#define WORLD_SAFE_RADIUS 2
+
+struct ChunkKey {
+    int64_t cx;
+    int64_t cy;
+    bool operator==(const ChunkKey& o) const { return cx == o.cx && cy == o.cy; }
+};
+
+struct ChunkKeyHash {
+    size_t operator()(const ChunkKey& k) const {
+        uint64_t h = (uint64_t)k.cx * 0x9E3779B97F4A7C15ull ^ (uint64_t)k.cy * 0xC2B2AE3D27D4EB4Full;
+        return (size_t)(h ^ (h >> 29));
+    }
+};
+
+// 完整形式：每格 1 字节，布局同 cell.h，按行存放
+struct Chunk {
+    ChunkKey key;
+    uint64_t lastUse;
+    uint8_t cells[CHUNK_CELLS];
+};
+
+// 压缩形式：只记玩家状态，每行一个 64 位字
+struct CompactChunk {
+    uint64_t revealed[CHUNK_SIZE];
+    uint64_t flagged[CHUNK_SIZE];
+};
+
+struct ChunkWorld {
+    uint64_t seed;
+    uint64_t tick;                  // 每次取用区块加 1，用于挑出最久没用的区块
+    int64_t revealedCount;          // 全世界已翻开的格子数（即得分）
+    int64_t generatedChunks;        // 累计生成（含重新生成）的区块数
+    std::unordered_map<ChunkKey, Chunk*, ChunkKeyHash> active;
+    std::unordered_map<ChunkKey, CompactChunk, ChunkKeyHash> compact;
+    std::vector<Chunk*> spare;      // 换出后留待复用的区块存储
+    Chunk* last;                    // 最近一次访问的区块，连续访问同一块时省去查表
+};
+
+void worldInit(ChunkWorld& world, uint64_t seed);
+void worldRelease(ChunkWorld& world);
+
+// 坐标所在的区块（向下取整，负坐标同样成立）
+inline int64_t worldChunkOf(int64_t v) {
+    return v >= 0 ? v >> CHUNK_SHIFT : -((-v - 1) >> CHUNK_SHIFT) - 1;
+}
+
+// 取格子，所在区块不在内存里时生成或从压缩形式恢复
+uint8_t& worldCell(ChunkWorld& world, int64_t x, int64_t y);
+
+// 只用于绘制：区块从未被碰过时返回 0（未翻开、无旗），不会触发生成
+uint8_t worldPeek(ChunkWorld& world, int64_t x, int64_t y);
+
+// 从 (x, y) 开始翻开，0 雷格子继续向 8 个邻格展开，可以跨越任意多个区块。
+// 新翻开的格子追加到 revealed（兼作队列），返回本次新增个数；雷格子不会被翻开
+int worldReveal(ChunkWorld& world, int64_t x, int64_t y, std::vector<WorldPos>& revealed);
+
+// 切换插旗；已翻开的格子不能插旗，返回切换后是否有旗
+bool worldToggleFlag(ChunkWorld& world, int64_t x, int64_t y);
+
+// 完整区块超过上限时，把区块坐标落在 [cx0, cx1] x [cy0, cy1] 以外、最久没用的区块换出
+void worldEvict(ChunkWorld& world, int64_t cx0, int64_t cy0, int64_t cx1, int64_t cy1);
+
+#endif // CHUNK_WORLD_H
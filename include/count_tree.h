@@ -0,0 +1,44 @@
+#ifndef COUNT_TREE_H
+#define COUNT_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "board.h"
+
+// ================= 计数四叉树：小地图背后的聚合结构 =================
+// 第 level 层的结点覆盖 2^level x 2^level 格，记录其中已翻开和插旗的格子数，未翻开的用面积减出来。
+// 只存 COUNT_TREE_LEAF_SHIFT 及以上的层，每层一张哈希表，只有计数不为 0 的结点才占内存，
+// 所以 100 万 x 100 万的稀疏棋盘也只按碰过的区域付内存。
+// 翻开一批格子时先在叶子层合并，再逐层向上合并，每层只改动被碰到的结点；
+// 查询任意一个结点都是一次哈希查找，与棋盘大小无关。
+
+// 最底下一层的结点边长为 2^COUNT_TREE_LEAF_SHIFT；更细的尺度直接逐格查询
+#define COUNT_TREE_LEAF_SHIFT 4
+
+struct CountNode {
+    int64_t revealed;
+    int64_t flagged;
+};
+
+struct CountTree {
+    int64_t rows;
+    int64_t cols;
+    int topLevel;           // 一个结点即覆盖整块棋盘的层
+    // levels[l] 为第 COUNT_TREE_LEAF_SHIFT + l 层，键为结点的 行 * 该层每行结点数 + 列
+    std::vector<std::unordered_map<uint64_t, CountNode> > levels;
+};
+
+void countTreeInit(CountTree& tree, int64_t rows, int64_t cols);
+void countTreeRelease(CountTree& tree);
+
+// 记入 n 个新翻开的格子（x 为列、y 为行），每个格子只能记一次
+void countTreeAddRevealed(CountTree& tree, const WorldPos* cells, size_t n);
+// 格子插旗 (delta = 1) 或拔旗 (delta = -1)
+void countTreeAddFlag(CountTree& tree, int64_t x, int64_t y, int delta);
+
+// 第 level 层 (>= COUNT_TREE_LEAF_SHIFT) 第 ny 行第 nx 列的结点，没有记录时全为 0
+CountNode countTreeNode(const CountTree& tree, int level, int64_t nx, int64_t ny);
+
+#endif // COUNT_TREE_H
@@ -1,35 +1,42 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include <cstdint>
+#include "board.h"
+
 // 初始化并开始游戏，根据传入的模式 (1=简单, 2=困难, 3=专家)
 void Game();
+// 无尽模式：无限大的棋盘，按区块随用随生成
+void InfiniteGame();
+// 超大的低密度自定义棋盘：稀疏存储，在与无尽模式相同的视口里玩
+void SparseGame();
 
 // ================= 全局变量与基础辅助函数 =================
 void wait_for_enter();
-int randomInt(int low, int high);
-bool isMine(int cell);
-void updateAdjacentCount(int row, int col, int rows, int cols, int** mines);
-void generateMines(int rows, int cols, const int mineCount, int** mine);
+void play_bomb_sound();
+void play_victory_sound();
+void updateAdjacentCount(int row, int col, int cols, uint8_t* cells);
+// 首次点击 (r, c) 的安全区半径：1 保护 3x3，0 只保护点击格，-1 不保护
+int safeZoneRadius(int r, int c, int rows, int cols, int mineCount, bool SafeZone);
+bool boardFitsFirstClick(const uint8_t* cells, int r, int c, int rows, int cols, int mineCount, bool SafeZone);
+// 布雷：候选格子一次性构建，部分 Fisher-Yates 抽取，复杂度 O(rows*cols + mineCount)
+void generateMines(int r, int c, int rows, int cols, const int mineCount, uint8_t* cells, bool SafeZone, uint64_t seed);
+// 首次点击后把安全区内的雷挪到区外均匀随机的空格，并就地修正周围雷数，复杂度与棋盘大小无关。
+// 确实挪动了雷时返回 true
+bool relocateMines(int r, int c, int rows, int cols, int mineCount, uint8_t* cells, bool SafeZone, uint64_t seed);
 
 // ================= 游戏状态管理 =================
 extern int rows;
 extern int cols;
 extern int mineCount;
-extern int** mine;
+extern uint8_t* cells;      // (rows + 2) * (cols + 2) 个格子，带一圈哨兵，布局见 board.h
 extern bool SafeZone;
+extern uint64_t gameSeed;   // 0 表示每局随机取种子
+extern uint64_t boardSeed;  // 当前棋盘实际使用的种子
 
-void Mode(int mode);
 void initializeGame();
 void cleanupGame();
-
-// ================= 游戏核心逻辑 (展开、高亮、双击) =================
-void AutoSwitch(int x, int y, int** mine);
-bool TryChord(int x, int y, int* userMine);
-void UpdateHover(int x, int y, int& lastR, int& lastC, int** internalMine, int* userMine,
-				 int rows, int cols, char** Mine_lines);
-
-// ================= 游戏主逻辑函数 =================
-void DrawBoard(char** Mine_lines, int nlines);
-void ProcessGameLoop(int* userMine, char** Mine_lines, const char* titleStr, int winTarget);
+// 释放跨局复用的本局缓冲，程序退出前调用
+void releaseGameBuffers();
 
 #endif // GAME_H
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef OPENINGS_H
+#define OPENINGS_H
+
+#include <cstdint>
+#include <vector>
+
+// ================= 空白区 (opening) 索引与 3BV =================
+// 布雷完成后用并查集把 8 连通的 0 雷格子归为一个个空白区，
+// 每个区的格子连同其边界上的数字格连续存放在 members 里（CSR 布局）。
+// 点到空白区时直接翻开整段，不必再做一次展开；同一遍扫描顺带算出 3BV：
+// 空白区个数 + 不与任何 0 雷格子相邻的数字格个数，即通关所需的最少点击数。
+
+// 超过这个格子数（约 2000x2000）不建索引，翻开退回 revealFlood，3BV 也不计算
+#define OPENING_INDEX_MAX_CELLS (1 << 22)
+
+struct OpeningIndex {
+    bool valid;
+    int bbbv;                   // 3BV，索引无效时为 -1
+    std::vector<int> region;    // 每个带哨兵下标所属的空白区编号，非 0 雷格子为 -1
+    std::vector<int> start;     // 第 k 个区的格子为 members[start[k], start[k + 1])
+    std::vector<int> members;   // 各区的 0 雷格子与边界数字格（数字格可能同属几个区）
+    std::vector<int> order;     // 按区排好的 0 雷格子（建索引时的中间结果）
+    std::vector<int> scratch;   // 并查集父节点 / 数字格归属标记，跨局复用
+};
+
+// 为当前棋盘建立索引。棋盘过大时只把索引标记为无效并返回 false
+bool openingIndexBuild(OpeningIndex& index, const uint8_t* cells, int rows, int cols);
+
+inline void openingIndexInvalidate(OpeningIndex& index) {
+    index.valid = false;
+    index.bbbv = -1;
+}
+
+// idx 是已索引的 0 雷格子时，翻开它所在的整个空白区（已翻开的跳过），
+// 新翻开的下标追加到 revealed 并返回 true；否则什么也不做并返回 false
+bool openingIndexReveal(const OpeningIndex& index, uint8_t* cells, int idx, std::vector<int>& revealed);
+
+#endif // OPENINGS_H
@@ -0,0 +1,41 @@
+#ifndef REVEAL_H
+#define REVEAL_H
+
+#include <cstdint>
+#include <vector>
+
+// ================= 迭代式连锁翻开 =================
+// 从 start 开始翻开格子，周围 0 雷的格子继续向 8 个邻格展开。
+// 不递归：revealed 既是结果也是 BFS 队列，每个格子入队时就打上已翻开标记，
+// 所以每格最多处理一次，展开区域再大也不会爆栈。
+// 雷格子、已翻开的格子和哨兵格都不会再被翻开。
+// 新翻开的下标按翻开顺序追加到 revealed 末尾（不清空，可以连续多次调用），返回本次新增个数。
+int revealFlood(uint8_t* cells, int stride, int start, std::vector<int>& revealed);
+
+// ================= 按 8x8 小块展开 =================
+// 把带哨兵的棋盘看成 8x8 的小块，每块的“0 雷 / 雷 / 已翻开”各压成一个 64 位掩码，
+// 块内用移位与按位或一次扩散一整圈，块间只传递边缘的掩码。
+// 翻开的格子集合与 revealFlood 完全相同，只是 revealed 中的顺序不同；格子数组的布局不变。
+
+// 不少于这么多格子（含哨兵）的棋盘改用 revealTiles。bench_tiles 里 4000x4000 起它大片展开稳定快 1.1 到 1.4 倍，
+// 2000x2000 及以下与 revealFlood 互有胜负，所以门槛取在两者之间
+#define REVEAL_TILE_MIN_CELLS (1 << 23)
+
+int revealTiles(uint8_t* cells, int rows, int cols, int start, std::vector<int>& revealed);
+
+// ================= 多线程逐层展开 =================
+// 层同步 BFS：每一层的前沿切成若干块交给线程池，各线程用原子“或”抢占格子的已翻开位，
+// 抢到的线程负责把它放进下一层。每格仍只被翻开一次，翻开集合与 revealFlood 完全相同；
+// 同一层内的顺序取决于线程调度。线程池只有一个线程时各层直接串行执行。
+// revealFrom 不会自动选它：bench_parallel_reveal 里它在 1 到 8 个线程下都比 revealTiles 慢 1.7 倍以上，
+// 还没有测到划算的棋盘大小与线程数，需要时由调用方显式调用。
+
+// 一层的前沿每块至少这么多格子，前沿更小时该层不分块
+#define REVEAL_PARALLEL_GRAIN 4096
+
+int revealParallel(uint8_t* cells, int stride, int start, std::vector<int>& revealed);
+
+// 按棋盘大小选择 revealFlood 或 revealTiles
+int revealFrom(uint8_t* cells, int rows, int cols, int start, std::vector<int>& revealed);
+
+#endif // REVEAL_H
@@ -0,0 +1,33 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+// ================= 计数器式随机数发生器 (Philox4x32-10) =================
+// 每个棋盘持有一份独立状态，没有任何全局变量：
+//   - 同一组 (seed, rows, cols, mineCount) 在任何平台上都得到同一个序列；
+//   - 多个线程各自生成棋盘时互不干扰，无需加锁。
+struct BoardRng {
+    uint32_t key[2];
+    uint32_t counter[4];
+    uint32_t block[4];
+    int used;
+};
+
+// 由棋盘参数派生密钥；stream 用来区分同一棋盘上彼此独立的随机流
+void rngInit(BoardRng& rng, uint64_t seed, int rows, int cols, int mineCount, uint32_t stream = 0);
+uint32_t rngNext(BoardRng& rng);
+// 返回 [0, bound) 内的无偏均匀整数 (bound > 0)
+uint32_t rngBelow(BoardRng& rng, uint32_t bound);
+// 同上，bound 可以超过 32 位（超大稀疏棋盘的格子下标）
+uint64_t rngBelow64(BoardRng& rng, uint64_t bound);
+// 返回 [low, high] 内的无偏均匀整数
+int rngRange(BoardRng& rng, int low, int high);
+
+// 把种子和两个坐标混合成一个新种子（无尽模式按区块坐标派生各区块的种子）
+uint64_t rngHash(uint64_t seed, int64_t a, int64_t b);
+
+// 生成一个新的种子，范围 [1, INT_MAX]，方便玩家在自定义模式里原样输入复现
+uint64_t rngFreshSeed();
+
+#endif // RNG_H
@@ -0,0 +1,69 @@
+#ifndef SPARSE_BOARD_H
+#define SPARSE_BOARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "board.h"
+
+// ================= 稀疏棋盘：超大、低密度的自定义棋盘 =================
+// 不为每个格子分配字节：雷按行存成有序的列号 (CSR)，周围雷数在用到时二分查出；
+// 翻开 / 插旗状态放在按 64x64 分页的位图里，只有被碰过的页才分配。
+// 坐标与下标全部是 64 位，100000 x 100000、0.1% 雷的棋盘约占 40 MB。
+
+// 自定义棋盘每条边的上限（稀疏棋盘每行要 8 字节的行首下标）
+#define BOARD_MAX_SIDE (1 << 20)
+// 稠密棋盘（board.h 布局，int 下标）最多的格子数，超过时只能用稀疏棋盘
+#define DENSE_MAX_CELLS ((int64_t)1 << 28)
+// 少于这个格子数的棋盘一律用稠密布局
+#define SPARSE_MIN_CELLS ((int64_t)1 << 24)
+// 稀疏棋盘最多的雷数（每颗雷 4 字节）
+#define SPARSE_MAX_MINES (1 << 26)
+// 单次展开最多翻开的格子数；到达上限时没来得及展开的空白格保持未翻开，再点一下即可继续
+#define SPARSE_FLOOD_LIMIT (1 << 20)
+#define SPARSE_PAGE_SHIFT 6
+#define SPARSE_PAGE_SIZE (1 << SPARSE_PAGE_SHIFT)
+
+// 一页 64x64 格的玩家状态，每行一个 64 位字
+struct SparsePage {
+    uint64_t revealed[SPARSE_PAGE_SIZE];
+    uint64_t flagged[SPARSE_PAGE_SIZE];
+};
+
+struct SparseBoard {
+    int64_t rows;
+    int64_t cols;
+    int64_t mineCount;
+    int64_t pageCols;               // 每行的页数
+    int64_t revealedCount;
+    std::vector<int64_t> rowStart;  // rows + 1 个，第 r 行的雷是 mineCols[rowStart[r], rowStart[r + 1])
+    std::vector<uint32_t> mineCols; // 各行内升序
+    std::unordered_map<int64_t, SparsePage> pages;
+};
+
+// 按尺寸和密度选择后端：稠密布局放不下，或稀疏存储不到稠密的 1/16 时用稀疏棋盘
+bool boardPrefersSparse(int64_t rows, int64_t cols, int64_t mineCount);
+// 自定义模式允许的最大雷数
+int64_t boardMaxMines(int64_t rows, int64_t cols);
+
+// 按种子均匀布雷（不考虑首次点击），同一组参数总得到同一个棋盘
+void sparseGenerate(SparseBoard& board, int rows, int cols, int mineCount, uint64_t seed);
+// 首次点击后把安全区里的雷挪走，规则与 relocateMines 相同；确实挪动了雷时返回 true
+bool sparseRelocate(SparseBoard& board, int64_t r, int64_t c, bool SafeZone, uint64_t seed);
+void sparseRelease(SparseBoard& board);
+
+bool sparseIsMine(const SparseBoard& board, int64_t r, int64_t c);
+int sparseCount(const SparseBoard& board, int64_t r, int64_t c);
+// 拼出 cell.h 格式的单字节状态，方便与稠密棋盘共用绘制代码
+uint8_t sparseCell(const SparseBoard& board, int64_t r, int64_t c);
+
+// 从 (r, c) 开始翻开，规则同 revealFlood；新翻开的格子追加到 revealed，返回新增个数
+int sparseReveal(SparseBoard& board, int64_t r, int64_t c, std::vector<WorldPos>& revealed);
+// 切换插旗；已翻开的格子不能插旗，返回切换后是否有旗
+bool sparseToggleFlag(SparseBoard& board, int64_t r, int64_t c);
+
+// 当前占用的堆内存（字节）
+size_t sparseBytes(const SparseBoard& board);
+
+#endif // SPARSE_BOARD_H
@@ -0,0 +1,31 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+// ================= 按行分块的并行循环 =================
+// 常驻的工作线程第一次用到时才启动。调用线程自己也参与干活。
+// 每块只写自己负责的行，结果与串行执行逐字节相同，跟线程数无关。
+
+// 每块的回调：context 为调用方传入的上下文
+typedef void (*ParallelBody)(const void* context, int blockBegin, int blockEnd);
+
+// 把 [begin, end) 切成每块至少 grain 个元素的若干块，并行执行 body(context, blockBegin, blockEnd)，
+// 全部完成后返回。区间不足两块、或线程池正被别的线程占用时直接在当前线程串行执行
+void parallelForRaw(int begin, int end, int grain, ParallelBody body, const void* context);
+
+// 同上，body 为任意可调用对象 body(blockBegin, blockEnd)。
+// 只传它的地址，不像 std::function 那样可能为较大的闭包分配堆内存
+template <class Body>
+void parallelFor(int begin, int end, int grain, const Body& body) {
+    parallelForRaw(begin, end, grain, [](const void* context, int from, int to) {
+        (*static_cast<const Body*>(context))(from, to);
+    }, &body);
+}
+
+// 参与并行的线程数（含调用线程）；n <= 0 表示按 CPU 核数
+void parallelSetThreads(int n);
+int parallelThreads();
+
+// 停止并回收工作线程，程序退出前调用
+void parallelShutdown();
+
+#endif // THREAD_POOL_H
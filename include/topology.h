@@ -0,0 +1,252 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "board.h"
+#include "rng.h"
+
+// ================= 拓扑：格子之间怎样相邻 =================
+// 布雷、计数、展开、双击只通过拓扑访问邻格，下面的内核按拓扑类型模板化，
+// 每种拓扑各自在编译期展开成专用的代码，固定邻域没有虚调用或查表的开销。
+// 每种拓扑提供同样的接口：
+//   rows() / cols()              决定随机流（rngInit）的两个尺寸参数
+//   cellCount()                  格子数组的字节数（含哨兵）
+//   nodeCount() / node(i)        可玩的格子个数，以及第 i 个可玩格子在数组里的下标
+//   writeBorder(cells)           写入哨兵格（没有哨兵的拓扑什么都不做）
+//   forEachNeighbour(idx, f)     对 idx 的每个邻格下标调用 f，可能包括哨兵格
+// 哨兵格 = CELL_BORDER | CELL_REVEALED，内核不必区分它与普通格子。
+
+// 方格：8 邻域，顺序同 NEIGHBOURS，布局见 board.h。Geometry 为 board_fixed.h 里的 FixedGeometry 或 DynamicGeometry
+template <class Geometry>
+struct SquareTopology {
+    Geometry g;
+
+    int rows() const { return g.rows(); }
+    int cols() const { return g.cols(); }
+    size_t cellCount() const { return g.cellCount(); }
+    int nodeCount() const { return g.rows() * g.cols(); }
+    int node(int i) const { return boardIndex(i / g.cols(), i % g.cols(), g.stride()); }
+    void writeBorder(uint8_t* cells) const { boardWriteBorder(cells, g.rows(), g.cols()); }
+
+    template <class F>
+    void forEachNeighbour(int idx, F f) const {
+        const int s = g.stride();
+        f(idx - s - 1);
+        f(idx - s);
+        f(idx - s + 1);
+        f(idx - 1);
+        f(idx + 1);
+        f(idx + s - 1);
+        f(idx + s);
+        f(idx + s + 1);
+    }
+};
+
+// 环面：上下、左右两边首尾相接，没有边界也没有哨兵，rows * cols 个格子按行存放。
+// 行数、列数都要不小于 3，否则同一个格子会从两个方向各算一次邻格
+struct TorusTopology {
+    int rowCount;
+    int colCount;
+
+    int rows() const { return rowCount; }
+    int cols() const { return colCount; }
+    size_t cellCount() const { return (size_t)rowCount * colCount; }
+    int nodeCount() const { return rowCount * colCount; }
+    int node(int i) const { return i; }
+    void writeBorder(uint8_t*) const {}
+
+    template <class F>
+    void forEachNeighbour(int idx, F f) const {
+        const int r = idx / colCount, c = idx - r * colCount;
+        const int up = r > 0 ? -colCount : (rowCount - 1) * colCount;
+        const int down = r < rowCount - 1 ? colCount : -(rowCount - 1) * colCount;
+        const int left = c > 0 ? -1 : colCount - 1;
+        const int right = c < colCount - 1 ? 1 : -(colCount - 1);
+        f(idx + up + left);
+        f(idx + up);
+        f(idx + up + right);
+        f(idx + left);
+        f(idx + right);
+        f(idx + down + left);
+        f(idx + down);
+        f(idx + down + right);
+    }
+};
+
+// 六边形：轴向坐标下的菱形棋盘，6 个邻格的 (行, 列) 偏移对每一格都相同，
+// 所以沿用 board.h 带哨兵的布局，邻格偏移与方格一样是常量。
+// 显示时第 r 行整体向右错开 r 个半格，即得到正六边形的排布。邻格顺序同 HEX_NEIGHBOURS
+static constexpr NeighbourDelta HEX_NEIGHBOURS[6] = {
+    {-1, 0}, {-1, 1},
+    { 0, -1}, { 0, 1},
+    { 1, -1}, { 1, 0},
+};
+
+template <class Geometry>
+struct HexTopology {
+    Geometry g;
+
+    int rows() const { return g.rows(); }
+    int cols() const { return g.cols(); }
+    size_t cellCount() const { return g.cellCount(); }
+    int nodeCount() const { return g.rows() * g.cols(); }
+    int node(int i) const { return boardIndex(i / g.cols(), i % g.cols(), g.stride()); }
+    void writeBorder(uint8_t* cells) const { boardWriteBorder(cells, g.rows(), g.cols()); }
+
+    template <class F>
+    void forEachNeighbour(int idx, F f) const {
+        const int s = g.stride();
+        f(idx - s);
+        f(idx - s + 1);
+        f(idx - 1);
+        f(idx + 1);
+        f(idx + s - 1);
+        f(idx + s);
+    }
+};
+
+// 任意图：邻接表按 CSR 存放，结点 i 的邻居是 targets[starts[i], starts[i + 1])。
+// 格子数组每个结点 1 字节、没有哨兵；周围雷数只有 4 位，每个结点至多 15 个邻居，且不能有重边和自环
+struct GraphTopology {
+    int nodes;
+    const int* starts;      // nodes + 1 个
+    const int* targets;
+
+    int rows() const { return nodes; }
+    int cols() const { return 1; }
+    size_t cellCount() const { return nodes > 0 ? (size_t)nodes : 0; }
+    int nodeCount() const { return nodes; }
+    int node(int i) const { return i; }
+    void writeBorder(uint8_t*) const {}
+
+    template <class F>
+    void forEachNeighbour(int idx, F f) const {
+        for (int e = starts[idx]; e < starts[idx + 1]; e++) f(targets[e]);
+    }
+};
+
+// ================= 按拓扑模板化的内核 =================
+
+// 部分 Fisher-Yates：在 candidates 的前 total 个里均匀抽 mineCount 颗雷，[from, to) 为雷格子。
+// 雷密度超过 50% 时改为抽取“安全格子”，抽中的以外全部布雷，抽取次数始终不超过一半
+inline void drawFromCandidates(BoardRng& rng, int* candidates, int total, int mineCount, int& from, int& to) {
+    int toPlace = mineCount < total ? mineCount : total;
+    bool invert = toPlace > total / 2;
+    int draws = invert ? total - toPlace : toPlace;
+
+    for (int k = 0; k < draws; k++) {
+        int pick = rngRange(rng, k, total - 1);
+        int tmp = candidates[k];
+        candidates[k] = candidates[pick];
+        candidates[pick] = tmp;
+    }
+
+    from = invert ? draws : 0;
+    to = invert ? total : draws;
+}
+
+// 从每颗雷出发给各邻格的计数加 1，然后写入雷标记和哨兵格。cells 进来时须全为 0
+template <class Topology>
+void topologyScatterCounts(const Topology& t, uint8_t* cells, const int* mines, int mineTotal) {
+    for (int m = 0; m < mineTotal; m++) {
+        uint8_t* base = cells;
+        t.forEachNeighbour(mines[m], [base](int n) { base[n]++; });
+    }
+    for (int m = 0; m < mineTotal; m++) {
+        cells[mines[m]] = CELL_MINE;
+    }
+    // 哨兵格上的计数是多加的，最后整体覆盖
+    t.writeBorder(cells);
+}
+
+// 首次点击 start 的安全区半径，规则同 safeZoneRadius：
+// 雷数允许时保护点击格和它的全部邻格 (1)，否则只保护点击格 (0)，再不行就不保护 (-1)
+template <class Topology>
+int topologySafeZoneRadius(const Topology& t, const uint8_t* cells, int start, int mineCount, bool SafeZone) {
+    if (!SafeZone || start < 0) return -1;
+
+    int zone = 1;
+    t.forEachNeighbour(start, [&](int n) { zone += !(cells[n] & CELL_BORDER); });
+    const int total = t.nodeCount();
+    if (mineCount <= total - zone) return 1;
+    if (mineCount < total) return 0;
+    return -1;
+}
+
+// 在拓扑 t 上布雷，首次点击 start（-1 表示不保护）。candidates 至少 nodeCount() 个 int。
+// 方格上候选的顺序与 buildCandidates 相同，同一种子得到与 generateMines 相同的棋盘
+template <class Topology>
+void topologyGenerateMines(const Topology& t, int start, int mineCount, bool SafeZone, uint64_t seed,
+                           uint8_t* cells, int* candidates) {
+    BoardRng rng;
+    rngInit(rng, seed, t.rows(), t.cols(), mineCount);
+
+    // 受保护的格子先在格子数组上临时打上旗标，构建候选时跳过
+    memset(cells, 0, t.cellCount());
+    t.writeBorder(cells);
+    int radius = topologySafeZoneRadius(t, cells, start, mineCount, SafeZone);
+    if (radius >= 0) cells[start] |= CELL_FLAG;
+    if (radius >= 1) {
+        t.forEachNeighbour(start, [cells](int n) {
+            if (!(cells[n] & CELL_BORDER)) cells[n] |= CELL_FLAG;
+        });
+    }
+
+    int total = 0;
+    for (int i = 0; i < t.nodeCount(); i++) {
+        int idx = t.node(i);
+        if (!(cells[idx] & CELL_FLAG)) candidates[total++] = idx;
+    }
+
+    int from, to;
+    drawFromCandidates(rng, candidates, total, mineCount, from, to);
+
+    memset(cells, 0, t.cellCount());
+    topologyScatterCounts(t, cells, candidates + from, to - from);
+}
+
+// 重新数 idx 周围的雷；雷格子不变
+template <class Topology>
+void topologyUpdateCount(const Topology& t, uint8_t* cells, int idx) {
+    uint8_t& cell = cells[idx];
+    if (cellIsMine(cell)) return;
+    int count = 0;
+    t.forEachNeighbour(idx, [&](int n) { count += cellIsMine(cells[n]); });
+    cell = (uint8_t)((cell & ~CELL_COUNT_MASK) | count);
+}
+
+// idx 周围插旗的格子数（哨兵格从不插旗）
+template <class Topology>
+int topologyFlagCount(const Topology& t, const uint8_t* cells, int idx) {
+    int flags = 0;
+    t.forEachNeighbour(idx, [&](int n) { flags += cellIsFlagged(cells[n]); });
+    return flags;
+}
+
+// 从 start 开始连锁翻开，规则与 revealFlood 相同：revealed 兼作 BFS 队列，
+// 入队时就打上已翻开标记，0 雷格子继续展开。新翻开的下标追加到 revealed，返回本次新增个数
+template <class Topology>
+int topologyReveal(const Topology& t, uint8_t* cells, int start, std::vector<int>& revealed) {
+    if (cells[start] & (CELL_REVEALED | CELL_MINE)) return 0;
+
+    size_t head = revealed.size();
+    const size_t first = head;
+    cells[start] |= CELL_REVEALED;
+    revealed.push_back(start);
+
+    while (head < revealed.size()) {
+        int idx = revealed[head++];
+        if (cellCount(cells[idx]) != 0) continue;
+        t.forEachNeighbour(idx, [&](int n) {
+            if (cells[n] & (CELL_REVEALED | CELL_MINE)) return;
+            cells[n] |= CELL_REVEALED;
+            revealed.push_back(n);
+        });
+    }
+    return (int)(revealed.size() - first);
+}
+
+#endif // TOPOLOGY_H
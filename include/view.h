@@ -0,0 +1,48 @@
+#ifndef VIEW_H
+#define VIEW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "board.h"
+
+// ================= 视口：只绘制棋盘的一个窗口 =================
+// 屏幕上最多显示 VIEW_ROWS x VIEW_COLS 格（紧凑画法为 VIEW_COMPACT_ROWS x VIEW_COMPACT_COLS）。
+// 棋盘更大时用 WASD、鼠标中键拖动或点击小地图移动视口；只绘制视口里的格子，每帧的输出与棋盘大小无关。
+// 鼠标坐标先按当前画法换算成视口里的行列，再加上视口左上角的坐标。
+// 普通棋盘、超大稀疏棋盘和无尽模式都通过 ViewBoard 接入。
+
+#define VIEW_ROWS 12
+#define VIEW_COLS 30
+// 紧凑画法每格只占 1 行 x 2 列，同样的 80x24 终端能放下更大的视口
+#define VIEW_COMPACT_ROWS 18
+#define VIEW_COMPACT_COLS 36
+
+// 视口背后的棋盘。x 为列、y 为行；rows / cols <= 0 表示没有边界，
+// firstClick / won / settle / formatWin 可以为空
+struct ViewBoard {
+    int64_t rows;
+    int64_t cols;
+    const int64_t* revealedCount;
+    uint8_t (*peek)(int64_t x, int64_t y);          // 只用于绘制，不应触发生成
+    uint8_t (*cell)(int64_t x, int64_t y);
+    // 新翻开的格子追加到 revealed；展开翻开插旗的格子时若把旗收回，收回的坐标追加到 unflagged
+    int (*reveal)(int64_t x, int64_t y, std::vector<WorldPos>& revealed, std::vector<WorldPos>& unflagged);
+    bool (*toggleFlag)(int64_t x, int64_t y);
+    void (*firstClick)(int64_t x, int64_t y);       // 第一次左键或右键点到棋盘上时调用
+    bool (*won)();
+    void (*settle)();                               // 每次操作之后调用
+    void (*formatTitle)(char* buf, size_t size);    // 标题栏，每次操作之后和每秒生成一次
+    void (*formatWin)(char* buf, size_t size);      // 获胜时的提示，为空时用默认的一句
+};
+
+extern int64_t viewCameraX;     // 视口左上角格子的坐标
+extern int64_t viewCameraY;
+extern int viewRows;            // 本局视口的行数、列数：有边界且较小的棋盘按棋盘大小
+extern int viewCols;
+extern bool viewCompact;        // 下一局起用紧凑画法（每格 1 行 x 2 列），整屏重画的字节数不到普通画法的 1/6
+
+// 在视口里玩 board，直到踩雷、获胜或按 Q 返回；进入前设好 viewCameraX / viewCameraY
+void viewRun(const ViewBoard& board);
+
+#endif // VIEW_H
@@ -1,16 +1,22 @@
 #include <iostream>
 #include "cgt.h"
 #include "game.h"
+#include "board_pool.h"
+#include "thread_pool.h"
+#include "sparse_board.h"
+#include "view.h"
 using namespace std;
 #include <string>
 #include <climits>
 #include <limits>
+#include <algorithm>
 
 static char ch = '\0';
 int rows, cols, mineCount;
 bool SafeZone = false;
+uint64_t gameSeed = 0;
 
-// ͨ cgt İӿڶȡһǸָλû
+// 通过 cgt 的按键接口读取一个非负整数并在指定位置回显
 int read_int_at(int x, int y, int color, int min_val = 1, int max_val = INT_MAX) {
     string s;
     char k = '\0';
@@ -19,11 +25,11 @@ int read_int_at(int x, int y, int color, int min_val = 1, int max_val = INT_MAX)
         cgt_get_key(k);
         if (k == '\n') {
             if (s.empty()) {
-                // 룬Ϊʾȡ
-                cgt_print_str("ʽ!", 1, 1, COLOR_RED);
+                // 空输入，视为错误，提示并继续读取
+                cgt_print_str("输入格式错误，请重新输入!", 1, 1, COLOR_RED);
                 cgt_msleep(1000);
                 cgt_print_str("                           ", 1, 1, COLOR_BLACK);
-                // ѻԵַ
+                // 清除已回显的字符
                 for (size_t i = 0; i < s.size(); ++i) cgt_print_char(' ', x + (int)i, y, COLOR_BLACK, COLOR_BLACK);
                 s.clear();
                 continue;
@@ -32,8 +38,8 @@ int read_int_at(int x, int y, int color, int min_val = 1, int max_val = INT_MAX)
             try {
                 val = stoi(s);
             } catch (...) {
-                // ʧ
-                cgt_print_str("ʽ!", 1, 1, COLOR_RED);
+                // 解析失败
+                cgt_print_str("输入格式错误，请重新输入!", 1, 1, COLOR_RED);
                 cgt_msleep(1000);
                 cgt_print_str("                            ", 1, 1, COLOR_BLACK);
                 for (size_t i = 0; i < s.size(); ++i) cgt_print_char(' ', x + (int)i, y, COLOR_BLACK, COLOR_BLACK);
@@ -41,7 +47,7 @@ int read_int_at(int x, int y, int color, int min_val = 1, int max_val = INT_MAX)
                 continue;
             }
             if (val < min_val || val > max_val) {
-                cgt_print_str("ʽ!", 1, 1, COLOR_RED);
+                cgt_print_str("输入格式错误，请重新输入!", 1, 1, COLOR_RED);
                 cgt_msleep(1000);
                 cgt_print_str("                            ", 1, 1, COLOR_BLACK);
                 for (size_t i = 0; i < s.size(); ++i) cgt_print_char(' ', x + (int)i, y, COLOR_BLACK, COLOR_BLACK);
@@ -75,45 +81,65 @@ void wait_input() {
                 }else{
                     cgt_print_str("OFF", 50, 12, COLOR_GREEN);
                 }
+            }else if (ch == 'c' || ch == 'C'){
+                viewCompact = !viewCompact;
+                if (viewCompact){
+                    cgt_print_str("ON ", 50, 13, COLOR_GREEN);
+                }else{
+                    cgt_print_str("OFF", 50, 13, COLOR_GREEN);
+                }
             }else if (ch == '1'){  
                 rows = 6;
                 cols = 6;
                 mineCount = 6;
+                gameSeed = 0;
                 return;
             }else if (ch == '2'){ 
                 rows = 9;
                 cols = 16;
                 mineCount = 20;
+                gameSeed = 0;
                 return;
             }else if (ch == '3'){
                 rows = 12;
                 cols = 30;
                 mineCount = 80;
+                gameSeed = 0;
                 return;
             }else if (ch == 'x' || ch == 'X'){
                 while (true){
                     cgt_clear_screen();
-                    cgt_print_str("Զģʽ(سÿ):", 10, 5, COLOR_LIGHT_BLUE);
+                    cgt_print_str("请输入自定义模式的行数和列数(按回车结束每项):", 10, 5, COLOR_LIGHT_BLUE);
                     cgt_print_str("rows: ", 11, 7, COLOR_YELLOW);
                     cgt_print_str("cols: ", 11, 8, COLOR_YELLOW);
-                    rows = read_int_at(17, 7, COLOR_YELLOW);
-                    cols = read_int_at(17, 8, COLOR_YELLOW); 
+                    rows = read_int_at(17, 7, COLOR_YELLOW, 1, BOARD_MAX_SIDE);
+                    cols = read_int_at(17, 8, COLOR_YELLOW, 1, BOARD_MAX_SIDE);
                     break;
                 }
                 while (true){
-                    cgt_print_str(":", 10, 11, COLOR_LIGHT_BLUE);
+                    cgt_print_str("请输入雷数:", 10, 11, COLOR_LIGHT_BLUE);
                     cgt_print_str("mineCount: ", 11, 13, COLOR_RED);
-                    mineCount = read_int_at(22, 13, COLOR_RED, 1, rows * cols);
+                    // 格子数按 64 位计算，超大棋盘上雷数的上限由稀疏棋盘决定
+                    int64_t maxMines = boardMaxMines(rows, cols);
+                    mineCount = read_int_at(22, 13, COLOR_RED, 1, (int)min(maxMines, (int64_t)INT_MAX));
+                    break;
+                }
+                while (true){
+                    cgt_print_str("请输入种子(输入 0 则随机生成, 相同种子可复现同一棋盘):", 10, 15, COLOR_LIGHT_BLUE);
+                    cgt_print_str("seed: ", 11, 17, COLOR_GREEN);
+                    gameSeed = (uint64_t)read_int_at(17, 17, COLOR_GREEN, 0);
                     break;
                 }
                     cgt_clear_screen();
-                    cgt_print_str("ɵ...", 10, 5, COLOR_LIGHT_BLUE);
+                    cgt_print_str("正在生成地雷...", 10, 5, COLOR_LIGHT_BLUE);
                     cgt_msleep(1200);
                     return;
+            }else if (ch == 'i' || ch == 'I'){
+                return;
             }else if (ch == 'q' || ch == 'Q'){
                 return;
             }else{
-                cgt_print_str("Чѡ!", 1, 1, COLOR_RED);
+                cgt_print_str("无效的选择，请重新输入!", 1, 1, COLOR_RED);
                 cgt_msleep(1000);
                 cgt_print_str("                       ", 1, 1, COLOR_BLACK);
                 continue;
@@ -127,22 +153,33 @@ void wait_input() {
 void print_menu() {
     while (true) {
         cgt_clear_screen();
-        cgt_print_str("ɨСϷ", 10, 5, COLOR_YELLOW);
-        cgt_print_str(" 1 ģʽ", 10, 7, COLOR_LIGHT_BLUE);
-        cgt_print_str(" 2 ģʽ", 10, 8, COLOR_LIGHT_BLUE);
-        cgt_print_str(" 3 רģʽ", 10, 9, COLOR_LIGHT_BLUE);
-        cgt_print_str(" X Զģʽ", 10, 10, COLOR_LIGHT_BLUE);
-        cgt_print_str("׵ã Y /رգ: ", 10, 12, COLOR_GREEN);
+        cgt_print_str("扫雷小游戏", 10, 5, COLOR_YELLOW);
+        cgt_print_str("按 1 进入简单模式", 10, 7, COLOR_LIGHT_BLUE);
+        cgt_print_str("按 2 进入困难模式", 10, 8, COLOR_LIGHT_BLUE);
+        cgt_print_str("按 3 进入专家模式", 10, 9, COLOR_LIGHT_BLUE);
+        cgt_print_str("按 X 进入自定义模式", 10, 10, COLOR_LIGHT_BLUE);
+        cgt_print_str("按 I 进入无尽模式", 10, 11, COLOR_LIGHT_BLUE);
+        cgt_print_str("首点击开阔区保护设置（按 Y 开启/关闭）: ", 10, 12, COLOR_GREEN);
         if (SafeZone){
             cgt_print_str("ON ", 50, 12, COLOR_GREEN);
         }else{
             cgt_print_str("OFF", 50, 12, COLOR_GREEN);
         }
-        cgt_print_str(" Q ˳Ϸ", 10, 14, COLOR_RED);
+        cgt_print_str("紧凑显示（每格 1x2 字符，按 C 开关）: ", 10, 13, COLOR_GREEN);
+        if (viewCompact){
+            cgt_print_str("ON ", 50, 13, COLOR_GREEN);
+        }else{
+            cgt_print_str("OFF", 50, 13, COLOR_GREEN);
+        }
+        cgt_print_str("按 Q 退出游戏", 10, 14, COLOR_RED);
         wait_input();
         if (ch == 'q' || ch == 'Q'){
             break;
         }
+        if (ch == 'i' || ch == 'I'){
+            InfiniteGame();
+            continue;
+        }
         Game();
     }
 }
@@ -151,6 +188,9 @@ int main() {
     cgt_init();
     cgt_clear_screen();
     print_menu();
+    boardPoolShutdown();
+    releaseGameBuffers();
+    parallelShutdown();
     cgt_clear_screen();
     cgt_close();
     return 0;
@@ -0,0 +1,64 @@
+#include "arena.h"
+#include <cstdlib>
+#include <new>
+
+void arenaReset(Arena& arena, size_t bytes) {
+    if (bytes > arena.capacity) {
+        delete[] arena.block;
+        arena.block = new uint8_t[bytes];
+        arena.capacity = bytes;
+    }
+    arena.used = 0;
+}
+
+void* arenaAlloc(Arena& arena, size_t bytes, size_t align) {
+    size_t start = (arena.used + align - 1) / align * align;
+    if (start + bytes > arena.capacity) return NULL;
+    arena.used = start + bytes;
+    return arena.block + start;
+}
+
+void arenaRelease(Arena& arena) {
+    delete[] arena.block;
+    arena.block = NULL;
+    arena.capacity = 0;
+    arena.used = 0;
+}
+
+// ================= 分配计数测试钩子 =================
+#ifdef MINESWEEPER_COUNT_ALLOCS
+#include <atomic>
+
+static std::atomic<size_t> allocations(0);
+
+size_t allocationCount() {
+    return allocations.load();
+}
+
+void* operator new(size_t bytes) {
+    allocations++;
+    void* p = malloc(bytes ? bytes : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t bytes) {
+    return operator new(bytes);
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    free(p);
+}
+#endif
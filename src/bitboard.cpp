@@ -0,0 +1,179 @@
+#include "bitboard.h"
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define BITBOARD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define BITBOARD_SSE2 1
+#endif
+
+using namespace std;
+
+// 一次处理的字数，四个位平面的临时结果都放在栈上 (4 * 64 * 8 = 2KB)
+#define PLANE_CHUNK 64
+
+void bitboardInit(Bitboard& bb, int rows, int cols) {
+    bb.rows = rows;
+    bb.cols = cols;
+    bb.words = (cols + 63) / 64 + 2;
+    bb.bits.assign((size_t)(rows + 2) * bb.words, 0);
+}
+
+// ================= 位平面加法 =================
+// 水平方向：左、中、右三格相加得到 0~3，存成两个位平面 (h1, h0)。
+// 竖直方向：上、中、下三行的 (h1, h0) 相加得到 0~9，存成四个位平面 (s3, s2, s1, s0)。
+// 同一套公式分别用标量 / SSE2 / AVX2 的“寄存器类型”实例化。
+
+struct ScalarOps {
+    typedef uint64_t V;
+    enum { LANES = 1 };
+    static V load(const uint64_t* p) { return *p; }
+    static void store(uint64_t* p, V v) { *p = v; }
+    static V shl1(V v) { return v << 1; }
+    static V shr1(V v) { return v >> 1; }
+    static V shl63(V v) { return v << 63; }
+    static V shr63(V v) { return v >> 63; }
+    static V andv(V a, V b) { return a & b; }
+    static V orv(V a, V b) { return a | b; }
+    static V xorv(V a, V b) { return a ^ b; }
+};
+
+#ifdef BITBOARD_SSE2
+struct Sse2Ops {
+    typedef __m128i V;
+    enum { LANES = 2 };
+    static V load(const uint64_t* p) { return _mm_loadu_si128((const __m128i*)p); }
+    static void store(uint64_t* p, V v) { _mm_storeu_si128((__m128i*)p, v); }
+    static V shl1(V v) { return _mm_slli_epi64(v, 1); }
+    static V shr1(V v) { return _mm_srli_epi64(v, 1); }
+    static V shl63(V v) { return _mm_slli_epi64(v, 63); }
+    static V shr63(V v) { return _mm_srli_epi64(v, 63); }
+    static V andv(V a, V b) { return _mm_and_si128(a, b); }
+    static V orv(V a, V b) { return _mm_or_si128(a, b); }
+    static V xorv(V a, V b) { return _mm_xor_si128(a, b); }
+};
+#endif
+
+#ifdef BITBOARD_AVX2
+struct Avx2Ops {
+    typedef __m256i V;
+    enum { LANES = 4 };
+    static V load(const uint64_t* p) { return _mm256_loadu_si256((const __m256i*)p); }
+    static void store(uint64_t* p, V v) { _mm256_storeu_si256((__m256i*)p, v); }
+    static V shl1(V v) { return _mm256_slli_epi64(v, 1); }
+    static V shr1(V v) { return _mm256_srli_epi64(v, 1); }
+    static V shl63(V v) { return _mm256_slli_epi64(v, 63); }
+    static V shr63(V v) { return _mm256_srli_epi64(v, 63); }
+    static V andv(V a, V b) { return _mm256_and_si256(a, b); }
+    static V orv(V a, V b) { return _mm256_or_si256(a, b); }
+    static V xorv(V a, V b) { return _mm256_xor_si256(a, b); }
+};
+#endif
+
+// 一行中从第 i 个字开始的 LANES 个字：左中右三格之和
+template <class Ops>
+static inline void horizontalSum(const uint64_t* row, int i, typename Ops::V& h0, typename Ops::V& h1) {
+    typedef typename Ops::V V;
+    V w = Ops::load(row + i);
+    V l = Ops::orv(Ops::shl1(w), Ops::shr63(Ops::load(row + i - 1)));
+    V r = Ops::orv(Ops::shr1(w), Ops::shl63(Ops::load(row + i + 1)));
+    V lw = Ops::xorv(l, w);
+    h0 = Ops::xorv(lw, r);
+    h1 = Ops::orv(Ops::andv(l, w), Ops::andv(r, lw));
+}
+
+// 处理字区间 [begin, end)，要求 (end - begin) 是 LANES 的整数倍
+template <class Ops>
+static void boxSumPlanes(const uint64_t* up, const uint64_t* mid, const uint64_t* down, int begin, int end,
+                         uint64_t* s0, uint64_t* s1, uint64_t* s2, uint64_t* s3) {
+    typedef typename Ops::V V;
+    for (int i = begin; i < end; i += Ops::LANES) {
+        V a0, a1, b0, b1, c0, c1;
+        horizontalSum<Ops>(up, i, a0, a1);
+        horizontalSum<Ops>(mid, i, b0, b1);
+        horizontalSum<Ops>(down, i, c0, c1);
+
+        // 权 1：三个低位相加
+        V ab0 = Ops::xorv(a0, b0);
+        V p0 = Ops::xorv(ab0, c0);
+        V carry2 = Ops::orv(Ops::andv(a0, b0), Ops::andv(c0, ab0));
+
+        // 权 2：三个高位加上低位进位
+        V ab1 = Ops::xorv(a1, b1);
+        V t = Ops::xorv(ab1, c1);
+        V m4 = Ops::orv(Ops::andv(a1, b1), Ops::andv(c1, ab1));
+        V p1 = Ops::xorv(t, carry2);
+        V carry4 = Ops::andv(t, carry2);
+
+        // 权 4 / 权 8
+        V p2 = Ops::xorv(m4, carry4);
+        V p3 = Ops::andv(m4, carry4);
+
+        int k = i - begin;
+        Ops::store(s0 + k, p0);
+        Ops::store(s1 + k, p1);
+        Ops::store(s2 + k, p2);
+        Ops::store(s3 + k, p3);
+    }
+}
+
+// spread[b] 的第 k 个字节等于 b 的第 k 位，用来把 8 个位一次展开成 8 个字节
+struct SpreadTable {
+    uint64_t v[256];
+    SpreadTable() {
+        for (int b = 0; b < 256; b++) {
+            uint64_t x = 0;
+            for (int k = 0; k < 8; k++) {
+                if (b & (1 << k)) x |= (uint64_t)1 << (8 * k);
+            }
+            v[b] = x;
+        }
+    }
+};
+static const SpreadTable spread;
+
+static inline void storeBytes(uint8_t* out, uint64_t v, int n) {
+    // 逐字节写出（与字节序无关），n 可能不足 8（行尾）
+    for (int k = 0; k < n; k++) out[k] = (uint8_t)(v >> (8 * k));
+}
+
+void bitboardRowCounts(const Bitboard& bb, int r, uint8_t* out) {
+    const uint64_t* up = bitboardRow(bb, r - 1);
+    const uint64_t* mid = bitboardRow(bb, r);
+    const uint64_t* down = bitboardRow(bb, r + 1);
+    const int dataWords = bb.words - 2;
+
+    uint64_t s0[PLANE_CHUNK], s1[PLANE_CHUNK], s2[PLANE_CHUNK], s3[PLANE_CHUNK];
+
+    for (int chunk = 0; chunk < dataWords; chunk += PLANE_CHUNK) {
+        int begin = 1 + chunk;
+        int end = begin + (dataWords - chunk < PLANE_CHUNK ? dataWords - chunk : PLANE_CHUNK);
+        int i = begin;
+#if defined(BITBOARD_AVX2)
+        int vecEnd = begin + ((end - begin) / 4) * 4;
+        boxSumPlanes<Avx2Ops>(up, mid, down, i, vecEnd, s0, s1, s2, s3);
+        i = vecEnd;
+#elif defined(BITBOARD_SSE2)
+        int vecEnd = begin + ((end - begin) / 2) * 2;
+        boxSumPlanes<Sse2Ops>(up, mid, down, i, vecEnd, s0, s1, s2, s3);
+        i = vecEnd;
+#endif
+        boxSumPlanes<ScalarOps>(up, mid, down, i, end, s0 + (i - begin), s1 + (i - begin),
+                                s2 + (i - begin), s3 + (i - begin));
+
+        // 把四个位平面拼回每格一个字节：每次展开 8 格
+        for (int w = 0; w < end - begin; w++) {
+            int col = (chunk + w) * 64;
+            for (int byte = 0; byte < 8 && col < bb.cols; byte++, col += 8) {
+                int shift = byte * 8;
+                uint64_t v = spread.v[(s0[w] >> shift) & 0xFF]
+                           | spread.v[(s1[w] >> shift) & 0xFF] << 1
+                           | spread.v[(s2[w] >> shift) & 0xFF] << 2
+                           | spread.v[(s3[w] >> shift) & 0xFF] << 3;
+                int n = bb.cols - col < 8 ? bb.cols - col : 8;
+                storeBytes(out + col, v, n);
+            }
+        }
+    }
+}
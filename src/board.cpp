@@ -0,0 +1,14 @@
+#include "board.h"
+#include <cstring>
+
+void boardWriteBorder(uint8_t* cells, int rows, int cols) {
+    const int stride = boardStride(cols);
+    const uint8_t border = CELL_BORDER | CELL_REVEALED;
+
+    memset(cells, border, stride);
+    memset(cells + (size_t)(rows + 1) * stride, border, stride);
+    for (int r = 1; r <= rows; r++) {
+        cells[(size_t)r * stride] = border;
+        cells[(size_t)r * stride + cols + 1] = border;
+    }
+}
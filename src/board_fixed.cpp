@@ -0,0 +1,14 @@
+#include "board_fixed.h"
+
+bool generatePresetMines(int r, int c, int rows, int cols, int mineCount, uint8_t* cells, bool SafeZone, uint64_t seed) {
+    if (rows == 6 && cols == 6) {
+        generateMinesFixed<6, 6>(r, c, mineCount, cells, SafeZone, seed);
+    } else if (rows == 9 && cols == 16) {
+        generateMinesFixed<9, 16>(r, c, mineCount, cells, SafeZone, seed);
+    } else if (rows == 12 && cols == 30) {
+        generateMinesFixed<12, 30>(r, c, mineCount, cells, SafeZone, seed);
+    } else {
+        return false;
+    }
+    return true;
+}
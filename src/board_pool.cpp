@@ -0,0 +1,135 @@
+#include "board_pool.h"
+#include "board.h"
+#include "game.h"
+#include "rng.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// 池中最多保留的棋盘数，以及所有预生成棋盘合计的内存上限；单块就超过上限的尺寸不预生成
+#define POOL_MAX_BOARDS 3
+#define POOL_MAX_BYTES ((size_t)256 << 20)
+
+static mutex poolMutex;
+static condition_variable poolCond;
+static thread poolWorker;
+static bool poolStarted = false;
+static bool poolStop = false;
+
+// 当前配置；poolGeneration 每换一次配置加 1，旧配置生成到一半的棋盘回来后直接丢弃
+static int poolRows = 0;
+static int poolCols = 0;
+static int poolMines = 0;
+static unsigned poolGeneration = 0;
+static int poolCapacity = 0;
+static int poolBusy = 0;
+
+static vector<PooledBoard> readyBoards;
+static vector<uint8_t*> spareBuffers;
+
+// 需持有 poolMutex
+static void ReleaseBuffers() {
+    for (size_t i = 0; i < readyBoards.size(); i++) delete[] readyBoards[i].cells;
+    for (size_t i = 0; i < spareBuffers.size(); i++) delete[] spareBuffers[i];
+    readyBoards.clear();
+    spareBuffers.clear();
+}
+
+static void PoolMain() {
+    unique_lock<mutex> lock(poolMutex);
+    while (true) {
+        poolCond.wait(lock, [] {
+            return poolStop || (int)readyBoards.size() + poolBusy < poolCapacity;
+        });
+        if (poolStop) break;
+
+        int rows = poolRows;
+        int cols = poolCols;
+        int mines = poolMines;
+        unsigned generation = poolGeneration;
+        uint8_t* buffer = NULL;
+        if (!spareBuffers.empty()) {
+            buffer = spareBuffers.back();
+            spareBuffers.pop_back();
+        }
+        poolBusy++;
+
+        // 生成过程不持锁，前台随时可以取棋盘或切换配置
+        lock.unlock();
+        if (!buffer) buffer = new uint8_t[boardCellCount(rows, cols)];
+        PooledBoard board;
+        board.cells = buffer;
+        board.seed = rngFreshSeed();
+        generateMines(-1, -1, rows, cols, mines, board.cells, false, board.seed);
+        lock.lock();
+
+        poolBusy--;
+        if (generation == poolGeneration) {
+            readyBoards.push_back(board);
+        } else {
+            delete[] board.cells;
+        }
+    }
+}
+
+void boardPoolConfigure(int rows, int cols, int mineCount) {
+    lock_guard<mutex> lock(poolMutex);
+    if (poolStarted && rows == poolRows && cols == poolCols && mineCount == poolMines) return;
+
+    ReleaseBuffers();
+    poolRows = rows;
+    poolCols = cols;
+    poolMines = mineCount;
+    poolGeneration++;
+
+    size_t fit = POOL_MAX_BYTES / boardCellCount(rows, cols);
+    poolCapacity = fit > POOL_MAX_BOARDS ? POOL_MAX_BOARDS : (int)fit;
+    // 一次留足容量，之后取还棋盘都不再触发扩容
+    readyBoards.reserve(poolCapacity);
+    spareBuffers.reserve(poolCapacity);
+
+    if (!poolStarted) {
+        poolStop = false;
+        poolWorker = thread(PoolMain);
+        poolStarted = true;
+    }
+    poolCond.notify_all();
+}
+
+bool boardPoolTake(int r, int c, bool safeZone, PooledBoard& out) {
+    lock_guard<mutex> lock(poolMutex);
+    for (size_t i = 0; i < readyBoards.size(); i++) {
+        if (boardFitsFirstClick(readyBoards[i].cells, r, c, poolRows, poolCols, poolMines, safeZone)) {
+            out = readyBoards[i];
+            readyBoards.erase(readyBoards.begin() + i);
+            // 不在这里唤醒后台：等 boardPoolRecycle 交回缓冲再生成下一块，免得它另分配一块
+            return true;
+        }
+    }
+    return false;
+}
+
+void boardPoolRecycle(uint8_t* cells) {
+    if (!cells) return;
+    lock_guard<mutex> lock(poolMutex);
+    spareBuffers.push_back(cells);
+    poolCond.notify_all();
+}
+
+void boardPoolShutdown() {
+    {
+        lock_guard<mutex> lock(poolMutex);
+        if (!poolStarted) return;
+        poolStop = true;
+        poolCond.notify_all();
+    }
+    poolWorker.join();
+
+    lock_guard<mutex> lock(poolMutex);
+    ReleaseBuffers();
+    poolStarted = false;
+    poolCapacity = 0;
+}
@@ -10,15 +10,18 @@
 #ifdef __APPLE__
 
 #include "./cgt.h"
+#include "cgt_frame.h"
 
 #include <iostream>
 #include <vector>
+#include <string>
 #include <cstdio>      // For printf, sscanf, EOF
 #include <unistd.h>    // For read, write, STDIN_FILENO, STDOUT_FILENO, usleep
 #include <termios.h>   // For terminal settings
 #include <csignal>     // For signal handling (Ctrl+C)
 #include <sys/select.h> // For non-blocking read check
 #include <cstring>     // For strchr
+#include <sys/ioctl.h> // For TIOCGWINSZ (terminal size)
 
 using namespace std;
 
@@ -51,6 +54,83 @@ struct CgtInputEvent {
 static vector<CgtInputEvent> inputBuffer;
 
 
+// --- Framebuffer: output is encoded as a diff and written once per frame ---
+
+static CgtFrame frame;
+static string frameOut;
+
+static void __cgt_write(const string& out) {
+    const char* p = out.data();
+    size_t left = out.size();
+    while (left > 0) {
+        ssize_t n = write(STDOUT_FILENO, p, left);
+        if (n <= 0) break;
+        p += n;
+        left -= n;
+    }
+}
+
+// Inside cgt_begin_frame / cgt_end_frame only the end of the frame presents
+static void __cgt_present(bool sync = false) {
+    if (frame.depth > 0) {
+        return;
+    }
+    frameOut.clear();
+    if (cgt_frame_present(frame, frameOut, sync)) {
+        __cgt_write(frameOut);
+    }
+}
+
+/**
+ * Asks the terminal whether it supports synchronized output (DEC mode 2026).
+ * The reply is left in the partial input buffer; the parser skips it as an unknown CSI.
+ */
+static bool __cgt_query_sync_output() {
+    if (!isatty(STDIN_FILENO) || !isatty(STDOUT_FILENO)) {
+        return false;
+    }
+    __cgt_write(CGT_SYNC_QUERY);
+
+    // 最多等 200 毫秒，每次 select 等 20 毫秒
+    for (int tries = 0; tries < 10; tries++) {
+        int len = strlen(__cgt_partial_input_buffer);
+        int reply = cgt_frame_parse_sync_reply(__cgt_partial_input_buffer, len);
+        if (reply >= 0) {
+            return reply == 1;
+        }
+
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(STDIN_FILENO, &fds);
+        struct timeval tv;
+        tv.tv_sec = 0;
+        tv.tv_usec = 20000;
+        if (select(STDIN_FILENO + 1, &fds, NULL, NULL, &tv) <= 0) {
+            continue;
+        }
+        int room = (int)sizeof(__cgt_partial_input_buffer) - 1 - len;
+        if (room <= 0) {
+            return false;
+        }
+        int bytesRead = read(STDIN_FILENO, __cgt_partial_input_buffer + len, room);
+        if (bytesRead > 0) {
+            __cgt_partial_input_buffer[len + bytesRead] = '\0';
+        }
+    }
+    return false;
+}
+
+static void __cgt_reset_frame(int color) {
+    struct winsize ws;
+    int cols = 0, rows = 0;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0) {
+        cols = ws.ws_col;
+        rows = ws.ws_row;
+    }
+    cgt_frame_reset(frame, color, cols, rows);
+}
+
+
 // --- Signal Handler for clean exit ---
 
 static void __cgt_signal_handler(int sig) {
@@ -91,6 +171,9 @@ void cgt_init() {
     signal(SIGINT, __cgt_signal_handler);
     signal(SIGTERM, __cgt_signal_handler);
 
+    __cgt_reset_frame(COLOR_BLACK);
+    frame.depth = 0;
+    frame.syncOutput = __cgt_query_sync_output();
     cgt_initialized = true;
 }
 
@@ -101,9 +184,12 @@ void cgt_close() {
     }
 
     // Use ANSI escape codes to clean up
+    frame.depth = 0;
+    __cgt_present();
     printf("\033[?1006l\033[?1003l\033[?1000l"); // Disable mouse reporting
     printf("\033[?25h"); // Show cursor
-    cgt_reset_color(); // Reset colors
+    printf("\033[0m"); // Reset colors
+    fflush(stdout);
 
     // Restore original terminal settings
     tcsetattr(STDIN_FILENO, TCSANOW, &original_termios);
@@ -117,6 +203,7 @@ void cgt_close() {
 
 
 void cgt_msleep(int milliseconds) {
+    __cgt_present();
     // usleep takes microseconds
     usleep(milliseconds * 1000);
 }
@@ -124,30 +211,6 @@ void cgt_msleep(int milliseconds) {
 
 // --- ANSI Color Helpers ---
 
-static int cgt_color_to_ansi_fg(int cgt_color) {
-    // cgt.h: 0:BLK, 1:BLU, 2:GRN, 3:CYA, 4:RED, 5:MAG, 6:YEL, 7:WHI
-    // ansi:  30:BLK, 31:RED, 32:GRN, 33:YEL, 34:BLU, 35:MAG, 36:CYA, 37:WHI
-    switch(cgt_color) {
-        case COLOR_BLACK:   return 30;
-        case COLOR_RED:     return 31;
-        case COLOR_GREEN:   return 32;
-        case COLOR_YELLOW:  return 33;
-        case COLOR_BLUE:    return 34;
-        case COLOR_MAGENTA: return 35;
-        case COLOR_CYAN:    return 36;
-        case COLOR_WHITE:   return 37;
-        case COLOR_LIGHT_BLACK:   return 90;
-        case COLOR_LIGHT_RED:     return 91;
-        case COLOR_LIGHT_GREEN:   return 92;
-        case COLOR_LIGHT_YELLOW:  return 93;
-        case COLOR_LIGHT_BLUE:    return 94;
-        case COLOR_LIGHT_MAGENTA: return 95;
-        case COLOR_LIGHT_CYAN:    return 96;
-        case COLOR_LIGHT_WHITE:   return 97;
-        default: return 37; // default white
-    }
-}
-
 static int cgt_color_to_ansi_bg(int cgt_color) {
     // Same as fg, but +10 for 0-7 and 8-15
     switch(cgt_color) {
@@ -172,16 +235,34 @@ static int cgt_color_to_ansi_bg(int cgt_color) {
 }
 
 
+void cgt_present() {
+    __cgt_present();
+}
+
+
+void cgt_begin_frame() {
+    frame.depth++;
+}
+
+
+void cgt_end_frame() {
+    if (frame.depth == 0) {
+        return;
+    }
+    if (--frame.depth == 0) {
+        __cgt_present(true);
+    }
+}
+
+
 void cgt_clear_screen(int color) {
-    // Set background color
-    printf("\033[%dm", cgt_color_to_ansi_bg(color));
-    // Clear entire screen (fills with current background)
-    printf("\033[2J");
-    // Move cursor to home (0, 0)
-    printf("\033[H");
-    // Reset attributes so future text isn't affected
-    printf("\033[0m");
-    fflush(stdout);
+    // Set background color, clear entire screen (fills with current background),
+    // move cursor to home (0, 0), reset attributes so future text isn't affected.
+    // Output not yet presented would be cleared anyway, so it is dropped.
+    char buf[32];
+    snprintf(buf, sizeof(buf), "\033[%dm\033[2J\033[H\033[0m", cgt_color_to_ansi_bg(color));
+    __cgt_write(buf);
+    __cgt_reset_frame(color);
 }
 
 
@@ -377,6 +458,7 @@ static void __cgt_read_input_to_buffer() {
 
 
 bool cgt_has_mouse() {
+    __cgt_present();
     __cgt_read_input_to_buffer();
     for (const CgtInputEvent& ev : inputBuffer) {
         if (ev.type == CGT_EVENT_MOUSE) {
@@ -404,6 +486,7 @@ void cgt_get_mouse(int& x, int& y, int& button, int& event) {
 
 
 bool cgt_has_key() {
+    __cgt_present();
     __cgt_read_input_to_buffer();
     for (const CgtInputEvent& ev : inputBuffer) {
         if (ev.type == CGT_EVENT_KEY) {
@@ -428,194 +511,65 @@ void cgt_get_key(char& ch) {
 
 
 // --- Cursor and Color Control ---
+// Colours are given with every print, and the cursor position is tracked by the
+// framebuffer, so neither needs a round trip to the terminal.
 
 void cgt_set_color(int foreground, int background) {
-    printf("\033[%d;%dm", cgt_color_to_ansi_fg(foreground), cgt_color_to_ansi_bg(background));
-    fflush(stdout); // Make color change immediate
+    (void)foreground;
+    (void)background;
 }
 
 
 void cgt_reset_color() {
-    printf("\033[0m"); // Reset all attributes
-    fflush(stdout);
 }
 
 
 void cgt_getxy(int &x, int &y) {
-    // 发送 DSR 请求
-    printf("\033[6n");
-    fflush(stdout);
-
-    char buf[256] = {0};
-    const long BUF_THRESHOLD = sizeof(buf) - 1;
-    
-    int bytesRead = 0;
-    char* r_pos = NULL;
-    
-    // --- 首先清空并使用我们的部分缓冲区 ---
-    int partialLen = strlen(__cgt_partial_input_buffer);
-    if (partialLen > 0) {
-        // 假设缓冲区不会溢出
-
-        if (partialLen < BUF_THRESHOLD) {
-            strcpy(buf, __cgt_partial_input_buffer);
-            bytesRead = partialLen;
-        } else {
-             // 不太可能，但为了安全
-             strncpy(buf, __cgt_partial_input_buffer, BUF_THRESHOLD);
-             buf[BUF_THRESHOLD] = '\0';
-             bytesRead = BUF_THRESHOLD;
-        }
-        __cgt_partial_input_buffer[0] = '\0'; // 清空它
-    }
-    
-    
-    // 读回报: \033[<row>;<col>R
-    // 轮询最多 100ms, 累积数据
-    for (int timeout = 0; timeout < 100; timeout++) {
-        if (__cgt_has_data_on_stdin()) {
-            int n = read(STDIN_FILENO, &buf[bytesRead], BUF_THRESHOLD - bytesRead);
-            if (n > 0) {
-                bytesRead += n;
-                buf[bytesRead] = '\0'; // Null-terminate
-            }
-        }
-        
-        // 检查我们是否有 *完整* 的回报
-        // 我们查找 \033[...R 模式
-        r_pos = strrchr(buf, 'R'); // 查找 *最后* 的 'R'
-        if (r_pos != NULL) {
-            char* esc_pos = r_pos;
-            // 向后扫描以查找匹配的 \033[
-            while (esc_pos > buf && *esc_pos != '[') {
-                esc_pos--;
-            }
-            if (*esc_pos == '[' && esc_pos > buf && *(esc_pos - 1) == '\033') {
-                 // 找到了一个潜在的 \033[...R
-                 break; // 假设这是我们的回报
-            }
-        }
-        
-        if (bytesRead >= BUF_THRESHOLD)
-            break; // 缓冲区满
-        usleep(1000); // 1ms
-    }
-
-    // 现在, 解析 buf. 它可能包含鼠标事件 *和* 回报.
-    x = 0; y = 0; // 默认
-    bool foundReport = false;
-    int reportStart = -1;
-    int reportEnd = -1;
-
-    // 我们在 r_pos 找到了候选的 'R'. 让我们 *向后* 解析
-    if (r_pos != NULL) {
-        char* start = r_pos - 1;
-        int row = 0, col = 0;
-
-        // 查找 ';'
-        while (start > buf && *start != ';') start--;
-        
-        if (*start == ';') {
-            // 找到 ';', 尝试从它后面解析 col
-            if (sscanf(start + 1, "%d", &col) == 1) {
-                // 现在查找 '['
-                while (start > buf && *start != '[') start--;
-                if (*start == '[' && start > buf && *(start-1) == '\033') {
-                    // 找到 \033[, 尝试从它后面解析 row
-                    if (sscanf(start + 1, "%d", &row) == 1) {
-                        // 成功! 我们找到了 \033[<row>;<col>R
-                        x = col - 1; // 1-indexed to 0-indexed
-                        y = row - 1;
-                        foundReport = true;
-                        reportStart = (int)(start - 1 - buf); // \033 的位置
-                        reportEnd = (int)(r_pos + 1 - buf); // R 之后的位置
-                    }
-                }
-            }
-        }
-    }
-
-
-    // 现在，解析报告 *周围* 的数据
-    if (foundReport) {
-        // --- 修复: 使用新的解析器并保存剩余部分 ---
-        // 先解析报告 *之后* 的数据
-        if (reportEnd < bytesRead) {
-            int consumed = __cgt_parse_input(&buf[reportEnd], bytesRead - reportEnd);
-            if (consumed < bytesRead - reportEnd) {
-                // 保存剩余
-                strcat(__cgt_partial_input_buffer, &buf[reportEnd + consumed]);
-            }
-        }
-        // 解析报告 *之前* 的数据
-        if (reportStart > 0) {
-            int consumed = __cgt_parse_input(buf, reportStart);
-             if (consumed < reportStart) {
-                // 保存剩余
-                strncat(__cgt_partial_input_buffer, &buf[consumed], reportStart - consumed);
-             }
-        }
-    } else {
-        // 没找到报告? 解析整个缓冲区.
-        if (bytesRead > 0) {
-            // --- 修复: 使用新的解析器并保存剩余部分 ---
-            int consumed = __cgt_parse_input(buf, bytesRead);
-            if (consumed < bytesRead) {
-                // 保存剩余
-                strcat(__cgt_partial_input_buffer, &buf[consumed]);
-            }
-        }
-    }
+    x = frame.cursorX;
+    y = frame.cursorY;
 }
 
 
 void cgt_gotoxy(int x, int y) {
-    int currentX, currentY;
-    if (x == -1 || y == -1) {
-        // Get current position if either coord is -1
-        cgt_getxy(currentX, currentY);
-    }
-    
-    int finalX = (x == -1) ? currentX : x;
-    int finalY = (y == -1) ? currentY : y;
-
-    // ANSI is 1-indexed (row, col)
-    printf("\033[%d;%dH", finalY + 1, finalX + 1);
-    fflush(stdout); // Make move immediate
+    if (x != -1) frame.cursorX = x;
+    if (y != -1) frame.cursorY = y;
 }
 
 
 // --- Print Functions ---
 
 void cgt_print_str(const char* str, int x, int y, int foreground, int background) {
-    cgt_set_color(foreground, background); // Flushes
-    cgt_gotoxy(x, y); // Flushes
-    cout << str;
-    cout.flush(); // Flush content
+    cgt_frame_put(frame, str, x, y, foreground, background);
 }
 
 
 void cgt_print_char(char ch, int x, int y, int foreground, int background) {
-    cgt_set_color(foreground, background);
-    cgt_gotoxy(x, y);
-    cout << ch;
-    cout.flush();
+    char str[2] = {ch, '\0'};
+    cgt_frame_put(frame, str, x, y, foreground, background);
+}
+
+
+void cgt_fill_span(int x, int y, int len, int foreground, int background, char ch) {
+    cgt_frame_fill(frame, ch, x, y, len, 1, foreground, background);
+}
+
+
+void cgt_fill_rect(int x, int y, int width, int height, int foreground, int background, char ch) {
+    cgt_frame_fill(frame, ch, x, y, width, height, foreground, background);
 }
 
 
 void cgt_print_int(int num, int x, int y, int foreground, int background) {
-    cgt_set_color(foreground, background);
-    cgt_gotoxy(x, y);
-    cout << num;
-    cout.flush();
+    char str[16];
+    snprintf(str, sizeof(str), "%d", num);
+    cgt_frame_put(frame, str, x, y, foreground, background);
 }
 
 
 void cgt_print_double(double num, int x, int y, int foreground, int background) {
-    cgt_set_color(foreground, background);
-    cgt_gotoxy(x, y);
-    cout << num;
-    cout.flush();
+    char str[32];
+    snprintf(str, sizeof(str), "%g", num);
+    cgt_frame_put(frame, str, x, y, foreground, background);
 }
 
 
@@ -0,0 +1,276 @@
+#include "cgt_frame.h"
+#include "cgt.h"
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+// cgt 颜色（Windows 控制台顺序）对应的 ANSI 前景色代码，背景色再加 10
+static const int ANSI_FG[16] = {
+    30, 34, 32, 36, 31, 35, 33, 37,
+    90, 94, 92, 96, 91, 95, 93, 97,
+};
+
+// 同一行里跳过不超过这么多格、且这些格子能用当前颜色原样重写时，直接重写比移动光标短
+#define CGT_FRAME_REWRITE_GAP 3
+
+static CgtCell BlankCell(int bg) {
+    CgtCell c;
+    c.glyph[0] = ' ';
+    c.len = 1;
+    c.fg = COLOR_WHITE;
+    c.bg = (signed char)bg;
+    return c;
+}
+
+// 终端上看起来是否一样：空格只看背景色
+static inline bool SameCell(const CgtCell& a, const CgtCell& b) {
+    if (a.len != b.len || b.len == CGT_CELL_UNKNOWN || a.bg != b.bg) return false;
+    if (a.len == 0) return true;
+    if (memcmp(a.glyph, b.glyph, a.len) != 0) return false;
+    return a.fg == b.fg || (a.len == 1 && a.glyph[0] == ' ');
+}
+
+// 中文、全角符号等在终端里占两格的字符
+static bool IsWide(unsigned cp) {
+    return (cp >= 0x1100 && cp <= 0x115F) || (cp >= 0x2E80 && cp <= 0xA4CF) ||
+           (cp >= 0xAC00 && cp <= 0xD7A3) || (cp >= 0xF900 && cp <= 0xFAFF) ||
+           (cp >= 0xFE30 && cp <= 0xFE4F) || (cp >= 0xFF00 && cp <= 0xFF60) ||
+           (cp >= 0xFFE0 && cp <= 0xFFE6) || (cp >= 0x1F300 && cp <= 0x1FAFF);
+}
+
+// 帧缓冲长到至少 w x h；新格子按上次清屏的底色算，终端上它们也是这个样子
+static void Grow(CgtFrame& f, int w, int h) {
+    if (w <= f.width && h <= f.height) return;
+    int nw = w > f.width ? w : f.width, nh = h > f.height ? h : f.height;
+    const CgtCell blank = BlankCell(f.blankBg);
+    vector<CgtCell> back((size_t)nw * nh, blank), front((size_t)nw * nh, blank);
+    for (int y = 0; y < f.height; y++) {
+        memcpy(&back[(size_t)y * nw], &f.back[(size_t)y * f.width], f.width * sizeof(CgtCell));
+        memcpy(&front[(size_t)y * nw], &f.front[(size_t)y * f.width], f.width * sizeof(CgtCell));
+    }
+    f.back.swap(back);
+    f.front.swap(front);
+    f.width = nw;
+    f.height = nh;
+}
+
+void cgt_frame_reset(CgtFrame& f, int bg, int screenCols, int screenRows) {
+    f.blankBg = bg;
+    f.back.assign((size_t)f.width * f.height, BlankCell(bg));
+    f.front = f.back;
+    f.cursorX = 0;
+    f.cursorY = 0;
+    f.termX = 0;
+    f.termY = 0;
+    f.termFg = -1;
+    f.termBg = -1;
+    f.screenCols = screenCols;
+    f.screenRows = screenRows;
+    f.dirty = false;
+    Grow(f, screenCols < CGT_FRAME_MAX_SIDE ? screenCols : CGT_FRAME_MAX_SIDE,
+         screenRows < CGT_FRAME_MAX_SIDE ? screenRows : CGT_FRAME_MAX_SIDE);
+}
+
+// 往 back 的 (x, y) 写一个 width 格宽的字符，维持“宽字符左格之后一定是右半格”
+static void PutCell(CgtFrame& f, int x, int y, const char* glyph, int len, int width, int fg, int bg) {
+    CgtCell* row = &f.back[(size_t)y * f.width];
+    CgtCell& cell = row[x];
+    // 盖住了别的宽字符的一半时，另一半变成同色的空格
+    if (cell.len == 0 && x > 0) row[x - 1] = BlankCell(row[x - 1].bg);
+    if (width == 2 ? x + 2 < f.width && row[x + 2].len == 0 : x + 1 < f.width && row[x + 1].len == 0) {
+        int tail = x + width;
+        row[tail] = BlankCell(row[tail].bg);
+    }
+    memcpy(cell.glyph, glyph, len);
+    cell.len = (unsigned char)len;
+    cell.fg = (signed char)fg;
+    cell.bg = (signed char)bg;
+    if (width == 2) {
+        row[x + 1].len = 0;
+        row[x + 1].fg = (signed char)fg;
+        row[x + 1].bg = (signed char)bg;
+    }
+}
+
+void cgt_frame_put(CgtFrame& f, const char* text, int x, int y, int fg, int bg) {
+    if (x == -1) x = f.cursorX;
+    if (y == -1) y = f.cursorY;
+    const unsigned char* p = (const unsigned char*)text;
+    while (*p) {
+        int len = *p < 0x80 ? 1 : *p >= 0xF0 ? 4 : *p >= 0xE0 ? 3 : *p >= 0xC0 ? 2 : 1;
+        unsigned cp = len == 1 ? *p : *p & (0x7F >> len);
+        for (int k = 1; k < len; k++) {
+            if ((p[k] & 0xC0) != 0x80) {
+                len = 1;    // 不合法的 UTF-8 按单字节原样输出
+                cp = *p;
+                break;
+            }
+            cp = (cp << 6) | (p[k] & 0x3F);
+        }
+        const int width = len > 1 && IsWide(cp) ? 2 : 1;
+        if (x >= 0 && y >= 0 && x + width <= CGT_FRAME_MAX_SIDE && y < CGT_FRAME_MAX_SIDE) {
+            Grow(f, x + width, y + 1);
+            PutCell(f, x, y, (const char*)p, len, width, fg, bg);
+            f.dirty = true;
+        }
+        x += width;
+        p += len;
+    }
+    f.cursorX = x;
+    f.cursorY = y;
+}
+
+void cgt_frame_fill(CgtFrame& f, char ch, int x, int y, int width, int height, int fg, int bg) {
+    if (x < 0) {
+        width += x;
+        x = 0;
+    }
+    if (y < 0) {
+        height += y;
+        y = 0;
+    }
+    if (x + width > CGT_FRAME_MAX_SIDE) width = CGT_FRAME_MAX_SIDE - x;
+    if (y + height > CGT_FRAME_MAX_SIDE) height = CGT_FRAME_MAX_SIDE - y;
+    if (width <= 0 || height <= 0) return;
+    Grow(f, x + width, y + height);
+
+    CgtCell fill;
+    fill.glyph[0] = ch;
+    fill.len = 1;
+    fill.fg = (signed char)fg;
+    fill.bg = (signed char)bg;
+    for (int j = y; j < y + height; j++) {
+        CgtCell* row = &f.back[(size_t)j * f.width];
+        // 两端盖住了宽字符的一半时，另一半变成同色的空格
+        if (row[x].len == 0 && x > 0) row[x - 1] = BlankCell(row[x - 1].bg);
+        if (x + width < f.width && row[x + width].len == 0) row[x + width] = BlankCell(row[x + width].bg);
+        for (int i = x; i < x + width; i++) row[i] = fill;
+    }
+    f.dirty = true;
+}
+
+// 把终端光标移到 (x, y)
+static void MoveTo(CgtFrame& f, string& out, int x, int y) {
+    if (f.termY == y && f.termX == x) return;
+    char buf[32];
+    if (f.termY == y && f.termX >= 0 && x > f.termX) {
+        // 跳过的几格如果能用当前颜色原样重写，重写它们
+        const CgtCell* row = &f.back[(size_t)y * f.width];
+        bool rewrite = x - f.termX <= CGT_FRAME_REWRITE_GAP;
+        for (int i = f.termX; rewrite && i < x; i++) {
+            const CgtCell& c = row[i];
+            rewrite = c.len == 1 && c.bg == f.termBg && (c.fg == f.termFg || c.glyph[0] == ' ');
+        }
+        if (rewrite) {
+            for (int i = f.termX; i < x; i++) out += row[i].glyph[0];
+        } else {
+            snprintf(buf, sizeof(buf), "\033[%dC", x - f.termX);
+            out += buf;
+        }
+    } else {
+        snprintf(buf, sizeof(buf), "\033[%d;%dH", y + 1, x + 1);
+        out += buf;
+    }
+    f.termX = x;
+    f.termY = y;
+}
+
+// 只发送真的变了的颜色；空格不换前景色
+static void SetColor(CgtFrame& f, string& out, const CgtCell& c) {
+    const bool needFg = c.fg != f.termFg && !(c.len == 1 && c.glyph[0] == ' ');
+    const bool needBg = c.bg != f.termBg;
+    if (!needFg && !needBg) return;
+    char buf[32];
+    if (needFg && needBg) {
+        snprintf(buf, sizeof(buf), "\033[%d;%dm", ANSI_FG[c.fg & 15], ANSI_FG[c.bg & 15] + 10);
+    } else {
+        snprintf(buf, sizeof(buf), "\033[%dm", needFg ? ANSI_FG[c.fg & 15] : ANSI_FG[c.bg & 15] + 10);
+    }
+    out += buf;
+    if (needFg) f.termFg = c.fg;
+    f.termBg = c.bg;
+}
+
+bool cgt_frame_present(CgtFrame& f, string& out, bool sync) {
+    if (!f.dirty) return false;
+    f.dirty = false;
+    const size_t before = out.size();
+    sync = sync && f.syncOutput;
+    if (sync) out += CGT_SYNC_BEGIN;
+    const size_t body = out.size();
+    const int cols = f.screenCols > 0 && f.screenCols < f.width ? f.screenCols : f.width;
+    const int rows = f.screenRows > 0 && f.screenRows < f.height ? f.screenRows : f.height;
+
+    for (int y = 0; y < rows; y++) {
+        const CgtCell* back = &f.back[(size_t)y * f.width];
+        CgtCell* front = &f.front[(size_t)y * f.width];
+        for (int x = 0; x < cols; x++) {
+            const CgtCell& c = back[x];
+            if (SameCell(c, front[x])) continue;
+            const int width = x + 1 < f.width && back[x + 1].len == 0 ? 2 : 1;
+            if (c.len == 0 || x + width > cols) {
+                // 孤立的右半格，或宽字符放不下这一行：终端上无从显示
+                front[x] = c;
+                continue;
+            }
+            MoveTo(f, out, x, y);
+            SetColor(f, out, c);
+
+            // 一长段同底色的空格：ECH 擦掉后光标不动，后面的格子照常比较，差异处再移过去
+            if (c.len == 1 && c.glyph[0] == ' ') {
+                int run = 1;
+                while (x + run < cols && back[x + run].len == 1 && back[x + run].glyph[0] == ' ' &&
+                       back[x + run].bg == c.bg) {
+                    run++;
+                }
+                if (run >= CGT_FRAME_ERASE_MIN) {
+                    char buf[32];
+                    snprintf(buf, sizeof(buf), "\033[%dX", run);
+                    out += buf;
+                    if (x + run < f.width && front[x + run].len == 0) front[x + run].len = CGT_CELL_UNKNOWN;
+                    for (int i = x; i < x + run; i++) front[i] = back[i];
+                    x += run - 1;
+                    continue;
+                }
+            }
+            out.append(c.glyph, c.len);
+
+            // 终端上被盖住一半的旧宽字符，另一半已经不是原来的样子
+            if (x + width < f.width && front[x + width].len == 0) front[x + width].len = CGT_CELL_UNKNOWN;
+            front[x] = c;
+            if (width == 2) front[x + 1] = back[x + 1];
+            x += width - 1;
+            f.termX += width;
+            // 写到最后一列后终端光标的位置因终端而异，下次重新定位
+            if (f.termX >= cols && f.screenCols > 0) f.termX = -1;
+        }
+    }
+    // 终端外的格子不显示，但也不必再比较
+    if (cols < f.width || rows < f.height) f.front = f.back;
+
+    if (out.size() == body) {
+        out.resize(before);
+        return false;
+    }
+    if (sync) out += CGT_SYNC_END;
+    return true;
+}
+
+int cgt_frame_parse_sync_reply(const char* buf, int len) {
+    static const char prefix[] = "\033[?2026;";
+    const int n = (int)sizeof(prefix) - 1;
+    for (int i = 0; i + 2 < len; i++) {
+        if (buf[i] != '\033' || buf[i + 1] != '[' || buf[i + 2] != '?') continue;
+        if (i + n + 3 <= len && memcmp(buf + i, prefix, n) == 0 && buf[i + n + 1] == '$' && buf[i + n + 2] == 'y') {
+            // Ps：0 不认识，1 / 2 可设置，3 永久开启，4 永久关闭
+            const char ps = buf[i + n];
+            return ps == '1' || ps == '2' || ps == '3';
+        }
+        // DA1 的回答 ESC [ ? ... c 先到了
+        int j = i + 3;
+        while (j < len && ((buf[j] >= '0' && buf[j] <= '9') || buf[j] == ';')) j++;
+        if (j < len && buf[j] == 'c') return 0;
+    }
+    return -1;
+}
@@ -14,14 +14,19 @@
     1. State Caching: Eliminates redundant ANSI codes.
     2. Zero-Copy Parsing: Fast manual pointer arithmetic.
     3. Output Buffering: Minimizes syscalls.
+       Output goes to a back/front cell framebuffer (cgt_frame.h); only changed
+       cells are encoded and written in one write() when input is polled,
+       on cgt_msleep, or on cgt_present.
     4. Synthetic Double-Click: Simulates Windows-like double click events.
 */
 
 #ifdef __linux__
 
 #include "./cgt.h"
+#include "cgt_frame.h"
 
 #include <vector>
+#include <string>
 #include <cstdio>       
 #include <unistd.h>     // read, write
 #include <termios.h>    
@@ -29,24 +34,24 @@
 #include <cstring>      
 #include <cstdlib>      
 #include <sys/time.h>   // For gettimeofday (Double click detection)
+#include <sys/ioctl.h>  // For TIOCGWINSZ (terminal size)
+#include <sys/select.h> // For select (terminal query replies)
 
 using namespace std;
 
 // --- Performance Constants ---
 #define INPUT_BUF_SIZE 4096
-#define OUTPUT_BUF_SIZE 65536 
 #define DOUBLE_CLICK_THRESHOLD_MS 400 // 双击判定阈值 (毫秒)
+#define SYNC_QUERY_TIMEOUT_MS 200     // 等终端回答同步输出询问的最长时间 (毫秒)
 
 // --- Globals ---
 
 static struct termios original_termios;
 static bool cgt_initialized = false;
 
-// --- State Caching ---
-static int _g_cur_fg = -1;
-static int _g_cur_bg = -1;
-static int _g_cur_x  = -1;
-static int _g_cur_y  = -1;
+// --- Framebuffer ---
+static CgtFrame _g_frame;
+static string _g_out;   // 本次要写出的字节，跨帧复用容量
 
 // --- Double Click State ---
 static long long _g_last_click_time = 0;
@@ -89,6 +94,64 @@ static int fast_parse_int(const char*& p) {
     return val;
 }
 
+// --- Helper: Write Whole Buffer ---
+static void __cgt_write(const string& out) {
+    const char* p = out.data();
+    size_t left = out.size();
+    while (left > 0) {
+        ssize_t n = write(STDOUT_FILENO, p, left);
+        if (n <= 0) break;
+        p += n;
+        left -= n;
+    }
+}
+
+// --- Helper: Present Framebuffer ---
+// Polling input or sleeping presents whatever was drawn, except inside
+// cgt_begin_frame / cgt_end_frame, where only the end of the frame presents.
+static void __cgt_present(bool sync = false) {
+    if (_g_frame.depth > 0) return;
+    _g_out.clear();
+    if (cgt_frame_present(_g_frame, _g_out, sync)) __cgt_write(_g_out);
+}
+
+// --- Helper: Detect Synchronized Output (DEC mode 2026) ---
+// The reply bytes stay in the input buffer; the parser skips them as unknown CSI.
+static bool __cgt_query_sync_output() {
+    if (!isatty(STDIN_FILENO) || !isatty(STDOUT_FILENO)) return false;
+    __cgt_write(CGT_SYNC_QUERY);
+
+    long long deadline = _cgt_get_time_ms() + SYNC_QUERY_TIMEOUT_MS;
+    while (true) {
+        int reply = cgt_frame_parse_sync_reply(__cgt_partial_input_buffer, __cgt_buffer_len);
+        if (reply >= 0) return reply == 1;
+        long long left = deadline - _cgt_get_time_ms();
+        if (left <= 0 || __cgt_buffer_len >= INPUT_BUF_SIZE) return false;
+
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(STDIN_FILENO, &fds);
+        struct timeval tv;
+        tv.tv_sec = 0;
+        tv.tv_usec = (long)left * 1000;
+        if (select(STDIN_FILENO + 1, &fds, NULL, NULL, &tv) <= 0) return false;
+        int n = read(STDIN_FILENO, __cgt_partial_input_buffer + __cgt_buffer_len, INPUT_BUF_SIZE - __cgt_buffer_len);
+        if (n <= 0) return false;
+        __cgt_buffer_len += n;
+    }
+}
+
+// --- Helper: Clear Terminal And Framebuffer ---
+static void __cgt_reset_frame(int color) {
+    struct winsize ws;
+    int cols = 0, rows = 0;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0) {
+        cols = ws.ws_col;
+        rows = ws.ws_row;
+    }
+    cgt_frame_reset(_g_frame, color, cols, rows);
+}
+
 // --- Signal Handler ---
 static void __cgt_signal_handler(int sig) {
     cgt_close();
@@ -96,20 +159,6 @@ static void __cgt_signal_handler(int sig) {
 }
 
 // --- ANSI Color Logic ---
-static int cgt_color_to_ansi_fg(int cgt_color) {
-    switch(cgt_color) {
-        case COLOR_BLACK:   return 30; case COLOR_RED:     return 31;
-        case COLOR_GREEN:   return 32; case COLOR_YELLOW:  return 33;
-        case COLOR_BLUE:    return 34; case COLOR_MAGENTA: return 35;
-        case COLOR_CYAN:    return 36; case COLOR_WHITE:   return 37;
-        case COLOR_LIGHT_BLACK:   return 90; case COLOR_LIGHT_RED:     return 91;
-        case COLOR_LIGHT_GREEN:   return 92; case COLOR_LIGHT_YELLOW:  return 93;
-        case COLOR_LIGHT_BLUE:    return 94; case COLOR_LIGHT_MAGENTA: return 95;
-        case COLOR_LIGHT_CYAN:    return 96; case COLOR_LIGHT_WHITE:   return 97;
-        default: return 37; 
-    }
-}
-
 static int cgt_color_to_ansi_bg(int cgt_color) {
     switch(cgt_color) {
         case COLOR_BLACK:   return 40; case COLOR_RED:     return 41;
@@ -138,8 +187,6 @@ void cgt_init() {
     new_termios.c_cc[VTIME] = 0; 
     tcsetattr(STDIN_FILENO, TCSANOW, &new_termios);
 
-    setvbuf(stdout, NULL, _IOFBF, OUTPUT_BUF_SIZE);
-
     printf("\033[?25l"); 
     // ?1000h: Click, ?1003h: Hover, ?1006h: SGR Coords
     printf("\033[?1000h\033[?1003h\033[?1006h"); 
@@ -148,8 +195,9 @@ void cgt_init() {
     signal(SIGINT, __cgt_signal_handler);
     signal(SIGTERM, __cgt_signal_handler);
 
-    _g_cur_fg = -1; _g_cur_bg = -1;
-    _g_cur_x = -1; _g_cur_y = -1;
+    __cgt_reset_frame(COLOR_BLACK);
+    _g_frame.depth = 0;
+    _g_frame.syncOutput = __cgt_query_sync_output();
     
     // Init double click state
     _g_last_click_time = 0;
@@ -162,9 +210,11 @@ void cgt_reset_color();
 void cgt_close() {
     if (!cgt_initialized) return;
 
+    _g_frame.depth = 0;
+    __cgt_present();
     printf("\033[?1006l\033[?1003l\033[?1000l"); 
     printf("\033[?25h"); 
-    cgt_reset_color(); 
+    printf("\033[0m");
     fflush(stdout);
 
     tcsetattr(STDIN_FILENO, TCSANOW, &original_termios);
@@ -175,16 +225,29 @@ void cgt_close() {
 }
 
 void cgt_msleep(int milliseconds) {
+    __cgt_present();
     usleep(milliseconds * 1000);
 }
 
+void cgt_present() {
+    __cgt_present();
+}
+
+void cgt_begin_frame() {
+    _g_frame.depth++;
+}
+
+void cgt_end_frame() {
+    if (_g_frame.depth == 0) return;
+    if (--_g_frame.depth == 0) __cgt_present(true);
+}
+
 void cgt_clear_screen(int color) {
-    printf("\033[%dm", cgt_color_to_ansi_bg(color));
-    printf("\033[2J\033[H\033[0m");
-    fflush(stdout);
-    
-    _g_cur_fg = -1; _g_cur_bg = -1;
-    _g_cur_x = 0; _g_cur_y = 0;
+    // 还没呈现的输出反正要被清掉，直接丢弃
+    char buf[32];
+    snprintf(buf, sizeof(buf), "\033[%dm\033[2J\033[H\033[0m", cgt_color_to_ansi_bg(color));
+    __cgt_write(buf);
+    __cgt_reset_frame(color);
 }
 
 // --- High Performance Input Parser ---
@@ -313,6 +376,7 @@ static void __cgt_read_input_to_buffer() {
 }
 
 bool cgt_has_mouse() {
+    __cgt_present();
     __cgt_read_input_to_buffer();
     for (const auto& ev : inputBuffer) if (ev.type == CGT_EVENT_MOUSE) return true;
     return false;
@@ -328,6 +392,7 @@ void cgt_get_mouse(int& x, int& y, int& button, int& event) {
 }
 
 bool cgt_has_key() {
+    __cgt_present();
     __cgt_read_input_to_buffer();
     for (const auto& ev : inputBuffer) if (ev.type == CGT_EVENT_KEY) return true;
     return false;
@@ -342,100 +407,55 @@ void cgt_get_key(char& ch) {
 }
 
 // --- Intelligent Rendering Control ---
+// 所有输出都写进帧缓冲，颜色随每次输出指定；等待输入或休眠时才把变化一次写出。
 
 void cgt_set_color(int foreground, int background) {
-    if (foreground == _g_cur_fg && background == _g_cur_bg) {
-        return;
-    }
-    printf("\033[%d;%dm", cgt_color_to_ansi_fg(foreground), cgt_color_to_ansi_bg(background));
-    _g_cur_fg = foreground;
-    _g_cur_bg = background;
+    (void)foreground;
+    (void)background;
 }
 
 void cgt_reset_color() {
-    printf("\033[0m");
-    _g_cur_fg = -1; _g_cur_bg = -1;
 }
 
 void cgt_getxy(int &x, int &y) {
-    fflush(stdout); 
-    printf("\033[6n");
-    fflush(stdout); 
-
-    char buf[128] = {0};
-    int r = 0;
-    fd_set fds;
-    struct timeval tv;
-    
-    for(int tries=0; tries<5; ++tries) {
-        FD_ZERO(&fds);
-        FD_SET(STDIN_FILENO, &fds);
-        tv.tv_sec = 0; tv.tv_usec = 50000; 
-
-        if (select(STDIN_FILENO + 1, &fds, NULL, NULL, &tv) > 0) {
-            int n = read(STDIN_FILENO, buf + r, 127 - r);
-            if (n > 0) r += n;
-            if (strchr(buf, 'R')) break; 
-        } else {
-            break; 
-        }
-    }
-    
-    int row = 0, col = 0;
-    char* p = strrchr(buf, '[');
-    if (p && sscanf(p, "[%d;%dR", &row, &col) == 2) {
-        x = col - 1; y = row - 1;
-        _g_cur_x = x; _g_cur_y = y; 
-    }
+    x = _g_frame.cursorX;
+    y = _g_frame.cursorY;
 }
 
 void cgt_gotoxy(int x, int y) {
-    int currentX = _g_cur_x;
-    int currentY = _g_cur_y;
-    
-    if (x == -1) x = (currentX == -1) ? 0 : currentX;
-    if (y == -1) y = (currentY == -1) ? 0 : currentY;
-
-    if (x == currentX && y == currentY) {
-        return;
-    }
-    printf("\033[%d;%dH", y + 1, x + 1);
-    _g_cur_x = x;
-    _g_cur_y = y;
+    if (x != -1) _g_frame.cursorX = x;
+    if (y != -1) _g_frame.cursorY = y;
 }
 
-// --- Print Functions ---
+// --- Output Functions ---
 
 void cgt_print_str(const char* str, int x, int y, int foreground, int background) {
-    cgt_set_color(foreground, background); 
-    cgt_gotoxy(x, y);                      
-    fputs(str, stdout); 
-    if (_g_cur_x != -1) _g_cur_x += strlen(str);
-    fflush(stdout); 
+    cgt_frame_put(_g_frame, str, x, y, foreground, background);
 }
 
 void cgt_print_char(char ch, int x, int y, int foreground, int background) {
-    cgt_set_color(foreground, background);
-    cgt_gotoxy(x, y);
-    putchar(ch);
-    if (_g_cur_x != -1) _g_cur_x++;
-    fflush(stdout);
+    char str[2] = {ch, '\0'};
+    cgt_frame_put(_g_frame, str, x, y, foreground, background);
+}
+
+void cgt_fill_span(int x, int y, int len, int foreground, int background, char ch) {
+    cgt_frame_fill(_g_frame, ch, x, y, len, 1, foreground, background);
+}
+
+void cgt_fill_rect(int x, int y, int width, int height, int foreground, int background, char ch) {
+    cgt_frame_fill(_g_frame, ch, x, y, width, height, foreground, background);
 }
 
 void cgt_print_int(int num, int x, int y, int foreground, int background) {
-    cgt_set_color(foreground, background);
-    cgt_gotoxy(x, y);
-    int len = printf("%d", num);
-    if (_g_cur_x != -1) _g_cur_x += len;
-    fflush(stdout);
+    char str[16];
+    snprintf(str, sizeof(str), "%d", num);
+    cgt_frame_put(_g_frame, str, x, y, foreground, background);
 }
 
 void cgt_print_double(double num, int x, int y, int foreground, int background) {
-    cgt_set_color(foreground, background);
-    cgt_gotoxy(x, y);
-    int len = printf("%g", num);
-    if (_g_cur_x != -1) _g_cur_x += len;
-    fflush(stdout);
+    char str[32];
+    snprintf(str, sizeof(str), "%g", num);
+    cgt_frame_put(_g_frame, str, x, y, foreground, background);
 }
 
 #endif // __linux__
\ No newline at end of file
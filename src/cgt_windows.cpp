@@ -98,6 +98,21 @@ void cgt_msleep(int milliseconds) {
 }
 
 
+// 控制台 API 直接写屏幕缓冲，没有要呈现的内容，帧也只是把 cout 攒到帧尾再刷出
+void cgt_present() {
+    cout.flush();
+}
+
+
+void cgt_begin_frame() {
+}
+
+
+void cgt_end_frame() {
+    cout.flush();
+}
+
+
 void cgt_clear_screen(int color) {
     CONSOLE_SCREEN_BUFFER_INFO csbi;
     if (!GetConsoleScreenBufferInfo(hOutput, &csbi)) {
@@ -301,6 +316,28 @@ void cgt_print_char(char ch, int x, int y, int foreground, int background) {
 }
 
 
+// 直接填屏幕缓冲：每行一次填字符、一次填颜色
+void cgt_fill_span(int x, int y, int len, int foreground, int background, char ch) {
+    if (len <= 0) {
+        return;
+    }
+    cout.flush();
+
+    COORD coord = { (short) x, (short) y };
+    WORD attributes = (WORD) ((foreground & 0x0F) | ((background & 0x0F) << 4));
+    DWORD written;
+    FillConsoleOutputCharacterA(hOutput, ch, len, coord, &written);
+    FillConsoleOutputAttribute(hOutput, attributes, len, coord, &written);
+}
+
+
+void cgt_fill_rect(int x, int y, int width, int height, int foreground, int background, char ch) {
+    for (int row = 0; row < height; row++) {
+        cgt_fill_span(x, y + row, width, foreground, background, ch);
+    }
+}
+
+
 void cgt_print_int(int num, int x, int y, int foreground, int background) {
     cgt_set_color(foreground, background);
     cgt_gotoxy(x, y);
@@ -0,0 +1,229 @@
+#include "chunk_world.h"
+#include "board.h"
+#include "rng.h"
+#include <algorithm>
+#include <cstring>
+
+// ================= 区块生成 =================
+
+// 区块 (cx, cy) 的雷分布，每行一个 64 位字。只取决于世界种子和区块坐标
+static void ChunkMineBits(uint64_t seed, int64_t cx, int64_t cy, uint64_t bits[CHUNK_SIZE]) {
+    BoardRng rng;
+    rngInit(rng, rngHash(seed, cx, cy), CHUNK_SIZE, CHUNK_SIZE, CHUNK_MINES);
+
+    // 部分 Fisher-Yates：前 CHUNK_MINES 个位置即为均匀抽出的雷
+    int slots[CHUNK_CELLS];
+    for (int i = 0; i < CHUNK_CELLS; i++) slots[i] = i;
+    for (int k = 0; k < CHUNK_MINES; k++) {
+        int pick = rngRange(rng, k, CHUNK_CELLS - 1);
+        int tmp = slots[k];
+        slots[k] = slots[pick];
+        slots[pick] = tmp;
+    }
+
+    memset(bits, 0, sizeof(uint64_t) * CHUNK_SIZE);
+    for (int k = 0; k < CHUNK_MINES; k++) {
+        bits[slots[k] >> CHUNK_SHIFT] |= (uint64_t)1 << (slots[k] & (CHUNK_SIZE - 1));
+    }
+
+    // 原点附近的安全区
+    for (int r = 0; r < CHUNK_SIZE; r++) {
+        int64_t y = cy * CHUNK_SIZE + r;
+        if (y < -WORLD_SAFE_RADIUS || y > WORLD_SAFE_RADIUS) continue;
+        for (int c = 0; c < CHUNK_SIZE; c++) {
+            int64_t x = cx * CHUNK_SIZE + c;
+            if (x >= -WORLD_SAFE_RADIUS && x <= WORLD_SAFE_RADIUS) bits[r] &= ~((uint64_t)1 << c);
+        }
+    }
+}
+
+// 生成区块的完整形式：自己的雷加上 8 个相邻区块的雷，算出每格的周围雷数
+static void BuildChunk(uint64_t seed, Chunk& chunk) {
+    uint64_t bits[3][3][CHUNK_SIZE];
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            ChunkMineBits(seed, chunk.key.cx + dx, chunk.key.cy + dy, bits[dy + 1][dx + 1]);
+        }
+    }
+
+    // (r, c) 可以越出本区块一格，落到相邻区块里
+    auto mineAt = [&](int r, int c) -> int {
+        int by = r < 0 ? 0 : (r >= CHUNK_SIZE ? 2 : 1);
+        int bx = c < 0 ? 0 : (c >= CHUNK_SIZE ? 2 : 1);
+        r -= (by - 1) * CHUNK_SIZE;
+        c -= (bx - 1) * CHUNK_SIZE;
+        return (int)((bits[by][bx][r] >> c) & 1);
+    };
+
+    for (int r = 0; r < CHUNK_SIZE; r++) {
+        for (int c = 0; c < CHUNK_SIZE; c++) {
+            uint8_t& cell = chunk.cells[r * CHUNK_SIZE + c];
+            if (mineAt(r, c)) {
+                cell = CELL_MINE;
+                continue;
+            }
+            int count = 0;
+            for (int k = 0; k < 8; k++) count += mineAt(r + NEIGHBOURS[k].dr, c + NEIGHBOURS[k].dc);
+            cell = (uint8_t)count;
+        }
+    }
+}
+
+// 生成区块，之前换出过的话把玩家状态恢复回去
+static Chunk* LoadChunk(ChunkWorld& world, const ChunkKey& key) {
+    Chunk* chunk;
+    if (!world.spare.empty()) {
+        chunk = world.spare.back();
+        world.spare.pop_back();
+    } else {
+        chunk = new Chunk;
+    }
+    chunk->key = key;
+    BuildChunk(world.seed, *chunk);
+    world.generatedChunks++;
+
+    auto saved = world.compact.find(key);
+    if (saved != world.compact.end()) {
+        const CompactChunk& state = saved->second;
+        for (int r = 0; r < CHUNK_SIZE; r++) {
+            for (int c = 0; c < CHUNK_SIZE; c++) {
+                uint8_t& cell = chunk->cells[r * CHUNK_SIZE + c];
+                if ((state.revealed[r] >> c) & 1) cell |= CELL_REVEALED;
+                if ((state.flagged[r] >> c) & 1) cell |= CELL_FLAG;
+            }
+        }
+        world.compact.erase(saved);
+    }
+
+    world.active[key] = chunk;
+    return chunk;
+}
+
+// ================= 世界 =================
+
+void worldInit(ChunkWorld& world, uint64_t seed) {
+    worldRelease(world);
+    world.seed = seed;
+}
+
+void worldRelease(ChunkWorld& world) {
+    for (auto& entry : world.active) delete entry.second;
+    for (size_t i = 0; i < world.spare.size(); i++) delete world.spare[i];
+    world.active.clear();
+    world.compact.clear();
+    world.spare.clear();
+    world.last = NULL;
+    world.tick = 0;
+    world.revealedCount = 0;
+    world.generatedChunks = 0;
+}
+
+static Chunk* ChunkAt(ChunkWorld& world, const ChunkKey& key) {
+    Chunk* chunk = world.last;
+    if (!chunk || !(chunk->key == key)) {
+        auto it = world.active.find(key);
+        chunk = it != world.active.end() ? it->second : LoadChunk(world, key);
+        world.last = chunk;
+    }
+    chunk->lastUse = ++world.tick;
+    return chunk;
+}
+
+uint8_t& worldCell(ChunkWorld& world, int64_t x, int64_t y) {
+    ChunkKey key = {worldChunkOf(x), worldChunkOf(y)};
+    Chunk* chunk = ChunkAt(world, key);
+    int r = (int)(y - key.cy * CHUNK_SIZE);
+    int c = (int)(x - key.cx * CHUNK_SIZE);
+    return chunk->cells[r * CHUNK_SIZE + c];
+}
+
+uint8_t worldPeek(ChunkWorld& world, int64_t x, int64_t y) {
+    ChunkKey key = {worldChunkOf(x), worldChunkOf(y)};
+    if (!world.active.count(key) && !world.compact.count(key)) return 0;
+    return worldCell(world, x, y);
+}
+
+int worldReveal(ChunkWorld& world, int64_t x, int64_t y, std::vector<WorldPos>& revealed) {
+    uint8_t& start = worldCell(world, x, y);
+    if (start & (CELL_REVEALED | CELL_MINE)) return 0;
+
+    // 区块存储都在堆上，展开途中生成新区块不会让已取到的引用失效；展开期间也不换出
+    size_t head = revealed.size();
+    const size_t first = head;
+    start |= CELL_REVEALED;
+    WorldPos origin = {x, y};
+    revealed.push_back(origin);
+
+    while (head < revealed.size() && revealed.size() - first < WORLD_FLOOD_LIMIT) {
+        WorldPos p = revealed[head++];
+        if (cellCount(worldCell(world, p.x, p.y)) != 0) continue;
+        for (int k = 0; k < 8; k++) {
+            WorldPos n = {p.x + NEIGHBOURS[k].dc, p.y + NEIGHBOURS[k].dr};
+            uint8_t& cell = worldCell(world, n.x, n.y);
+            if (cell & (CELL_REVEALED | CELL_MINE)) continue;
+            cell |= CELL_REVEALED;
+            revealed.push_back(n);
+        }
+    }
+
+    // 到达上限时，还没展开的空白格退回未翻开状态，玩家点它即可接着展开（同 sparseReveal）
+    size_t kept = head;
+    for (size_t i = head; i < revealed.size(); i++) {
+        WorldPos p = revealed[i];
+        uint8_t& cell = worldCell(world, p.x, p.y);
+        if (cellCount(cell) == 0) {
+            cell &= ~CELL_REVEALED;
+        } else {
+            revealed[kept++] = p;
+        }
+    }
+    revealed.resize(kept);
+
+    int added = (int)(revealed.size() - first);
+    world.revealedCount += added;
+    return added;
+}
+
+bool worldToggleFlag(ChunkWorld& world, int64_t x, int64_t y) {
+    uint8_t& cell = worldCell(world, x, y);
+    if (cellIsRevealed(cell)) return false;
+    cell ^= CELL_FLAG;
+    return cellIsFlagged(cell);
+}
+
+void worldEvict(ChunkWorld& world, int64_t cx0, int64_t cy0, int64_t cx1, int64_t cy1) {
+    if (world.active.size() <= WORLD_MAX_ACTIVE_CHUNKS) return;
+
+    std::vector<Chunk*> victims;
+    for (auto& entry : world.active) {
+        const ChunkKey& k = entry.first;
+        if (k.cx >= cx0 && k.cx <= cx1 && k.cy >= cy0 && k.cy <= cy1) continue;
+        victims.push_back(entry.second);
+    }
+    std::sort(victims.begin(), victims.end(), [](const Chunk* a, const Chunk* b) {
+        return a->lastUse < b->lastUse;
+    });
+
+    size_t excess = world.active.size() - WORLD_MAX_ACTIVE_CHUNKS;
+    for (size_t i = 0; i < victims.size() && i < excess; i++) {
+        Chunk* chunk = victims[i];
+        CompactChunk state;
+        bool touched = false;
+        for (int r = 0; r < CHUNK_SIZE; r++) {
+            uint64_t rev = 0, flag = 0;
+            for (int c = 0; c < CHUNK_SIZE; c++) {
+                uint8_t cell = chunk->cells[r * CHUNK_SIZE + c];
+                rev |= (uint64_t)cellIsRevealed(cell) << c;
+                flag |= (uint64_t)cellIsFlagged(cell) << c;
+            }
+            state.revealed[r] = rev;
+            state.flagged[r] = flag;
+            touched |= (rev | flag) != 0;
+        }
+        // 玩家没碰过的区块直接丢掉，需要时按种子重新生成即可
+        if (touched) world.compact[chunk->key] = state;
+        world.active.erase(chunk->key);
+        if (world.last == chunk) world.last = NULL;
+        world.spare.push_back(chunk);
+    }
+}
@@ -0,0 +1,86 @@
+#include "count_tree.h"
+#include <algorithm>
+
+using namespace std;
+
+// 第 level 层每行的结点数
+static inline int64_t LevelCols(const CountTree& tree, int level) {
+    return (tree.cols + ((int64_t)1 << level) - 1) >> level;
+}
+
+void countTreeInit(CountTree& tree, int64_t rows, int64_t cols) {
+    countTreeRelease(tree);
+    tree.rows = rows;
+    tree.cols = cols;
+    int top = COUNT_TREE_LEAF_SHIFT;
+    while (((int64_t)1 << top) < rows || ((int64_t)1 << top) < cols) top++;
+    tree.topLevel = top;
+    tree.levels.resize(top - COUNT_TREE_LEAF_SHIFT + 1);
+}
+
+void countTreeRelease(CountTree& tree) {
+    vector<unordered_map<uint64_t, CountNode> >().swap(tree.levels);
+    tree.rows = 0;
+    tree.cols = 0;
+    tree.topLevel = 0;
+}
+
+void countTreeAddRevealed(CountTree& tree, const WorldPos* cells, size_t n) {
+    if (n == 0 || tree.levels.empty()) return;
+
+    // (结点键, 增量)；展开的结果按 BFS 顺序排列，相邻格子大多落在同一片叶子里，先合并连续的一段
+    static thread_local vector<pair<uint64_t, int64_t> > batch;
+    batch.clear();
+    const int64_t leafCols = LevelCols(tree, COUNT_TREE_LEAF_SHIFT);
+    for (size_t i = 0; i < n; i++) {
+        uint64_t key = (uint64_t)((cells[i].y >> COUNT_TREE_LEAF_SHIFT) * leafCols + (cells[i].x >> COUNT_TREE_LEAF_SHIFT));
+        if (!batch.empty() && batch.back().first == key) {
+            batch.back().second++;
+        } else {
+            batch.push_back(make_pair(key, (int64_t)1));
+        }
+    }
+
+    for (size_t l = 0; l < tree.levels.size(); l++) {
+        // 同一结点的增量合并成一项，再写进这一层
+        sort(batch.begin(), batch.end());
+        size_t kept = 0;
+        for (size_t i = 0; i < batch.size(); i++) {
+            if (kept > 0 && batch[kept - 1].first == batch[i].first) {
+                batch[kept - 1].second += batch[i].second;
+            } else {
+                batch[kept++] = batch[i];
+            }
+        }
+        batch.resize(kept);
+        for (size_t i = 0; i < batch.size(); i++) {
+            CountNode& node = tree.levels[l][batch[i].first];
+            node.revealed += batch[i].second;
+        }
+        if (l + 1 == tree.levels.size()) break;
+
+        // 换成上一层父结点的键
+        const int level = COUNT_TREE_LEAF_SHIFT + (int)l;
+        const int64_t w = LevelCols(tree, level), parentW = LevelCols(tree, level + 1);
+        for (size_t i = 0; i < batch.size(); i++) {
+            int64_t ny = (int64_t)batch[i].first / w, nx = (int64_t)batch[i].first % w;
+            batch[i].first = (uint64_t)((ny >> 1) * parentW + (nx >> 1));
+        }
+    }
+}
+
+void countTreeAddFlag(CountTree& tree, int64_t x, int64_t y, int delta) {
+    for (size_t l = 0; l < tree.levels.size(); l++) {
+        const int level = COUNT_TREE_LEAF_SHIFT + (int)l;
+        uint64_t key = (uint64_t)((y >> level) * LevelCols(tree, level) + (x >> level));
+        tree.levels[l][key].flagged += delta;
+    }
+}
+
+CountNode countTreeNode(const CountTree& tree, int level, int64_t nx, int64_t ny) {
+    CountNode none = {0, 0};
+    size_t l = (size_t)(level - COUNT_TREE_LEAF_SHIFT);
+    if (level < COUNT_TREE_LEAF_SHIFT || l >= tree.levels.size()) return none;
+    auto it = tree.levels[l].find((uint64_t)(ny * LevelCols(tree, level) + nx));
+    return it != tree.levels[l].end() ? it->second : none;
+}
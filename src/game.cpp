@@ -1,24 +1,40 @@
 #include "cgt.h"
+#include "rng.h"
+#include "bitboard.h"
+#include "board.h"
+#include "board_fixed.h"
+#include "board_pool.h"
+#include "topology.h"
+#include "arena.h"
+#include "thread_pool.h"
+#include "reveal.h"
+#include "openings.h"
+#include "sparse_board.h"
+#include "view.h"
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
+#include <cstring>
 #include "stdlib.h"
+#include <vector>
+#include <algorithm>
+#include <memory>
 
-// ʹԤ꣬ƽ̨ݲƵͷļ
+// 使用预处理宏，跨平台兼容播放音频所需库和头文件
 #ifdef _WIN32
   #include <windows.h>
     #if defined(_MSC_VER)
         #pragma comment(lib, "winmm.lib")
     #endif
 #elif __APPLE__
-  // ݲҪΪ system("afplay ...") ͷļʹ stdlib.h 
+  // 暂不需要为 system("afplay ...") 引入特殊头文件，使用 stdlib.h 即可
 #elif __linux__
-  // ݲҪΪ system("aplay ... / mpg123 ...") ͷļʹ stdlib.h 
+  // 暂不需要为 system("aplay ... / mpg123 ...") 引入特殊头文件，使用 stdlib.h 即可
 #endif
 
 using namespace std;
 
-// ================= ȫֱ =================
+// ================= 全局变量与基础辅助函数 =================
 
 void play_bomb_sound() {
 #ifdef _WIN32
@@ -27,7 +43,7 @@ void play_bomb_sound() {
 #elif __APPLE__
     system("afplay resources/Bomb.mp3 &");
 #elif __linux__
-    // ʹ mpg123 ں̨ţȷϵͳѰװ mpg123 ޸Ϊ
+    // 使用 mpg123 在后台播放，确保系统已安装 mpg123 或者修改为其他播放器
     system("mpg123 -q resources/Bomb.mp3 &");
 #endif
 }
@@ -44,593 +60,412 @@ void play_victory_sound() {
 }
 
 void wait_for_enter() {
-    // ռ¼塣
+    // 清空键盘输入事件缓冲。
     while (cgt_has_key()) {
         char ch;
         cgt_get_key(ch);
     }
 
-    // ȴⰴ
+    // 等待任意按键。
     while (true) {
         if (cgt_has_key()) {
             char ch;
             cgt_get_key(ch);
-            // ⰴɽ
+            // 读到任意按键，都可结束。
             break;
         }
-        // ʵϢֹռ CPU
+        // 适当休息，防止占满电脑 CPU。
         cgt_msleep(50);
     }
 }
 
-int randomInt(int low, int high) {
-    static bool initialized = false;
-    if (!initialized) {
-        srand((unsigned int) time(nullptr));
-        initialized = true;
-    }
-    return low + rand() % (high - low + 1);
+void updateAdjacentCount(int row, int col, int cols, uint8_t* cells) {
+    // 哨兵格不是雷，邻格直接累加；计数只用到列数
+    SquareTopology<DynamicGeometry> t = {{0, cols}};
+    topologyUpdateCount(t, cells, boardIndex(row, col, boardStride(cols)));
 }
 
-bool isMine(int cell) {
-    return cell == '*';
+int safeZoneRadius(int r, int c, int rows, int cols, int mineCount, bool SafeZone) {
+    if (!SafeZone || r < 0 || c < 0) return -1;
+
+    // 计算理想状态下，3x3 安全区内的格子数量（按行、列方向分别裁剪到棋盘内）
+    int rowSpan = min(r + 1, rows - 1) - max(r - 1, 0) + 1;
+    int colSpan = min(c + 1, cols - 1) - max(c - 1, 0) + 1;
+    int x = rowSpan * colSpan;
+    // 稀疏棋盘的格子数可能超出 int
+    const int64_t cells = (int64_t)rows * cols;
+
+    if (mineCount <= cells - x) {
+        // 空间充足，开启完整的 3x3 保护
+        return 1;
+    } else if (mineCount < cells) {
+        // 空间不足以保护 3x3，降级为只保护玩家点击的这 1 个格子
+        return 0;
+    }
+    return -1;
 }
 
-void updateAdjacentCount(int row, int col, int rows, int cols, int** mines) {
-    if (isMine(mines[row][col]))
-        return;
- 
-    int count = 0;
-    for (int dr = -1; dr <= 1; dr++) {
-        for (int dc = -1; dc <= 1; dc++) {
-            int nr = row + dr;
-            int nc = col + dc;
-            if (nr >= 0 && nr < rows && nc >= 0 && nc < cols)
-                count += !!isMine(mines[nr][nc]);
+bool boardFitsFirstClick(const uint8_t* cells, int r, int c, int rows, int cols, int mineCount, bool SafeZone) {
+    int radius = safeZoneRadius(r, c, rows, cols, mineCount, SafeZone);
+    if (radius < 0) return true;
+
+    const int stride = boardStride(cols);
+    for (int i = max(r - radius, 0); i <= min(r + radius, rows - 1); i++) {
+        for (int j = max(c - radius, 0); j <= min(c + radius, cols - 1); j++) {
+            if (cellIsMine(cells[boardIndex(i, j, stride)])) return false;
         }
     }
-    mines[row][col] = count;
+    return true;
 }
 
-void generateMines(int r, int c, int rows, int cols, const int mineCount, int** mine, bool SafeZone) {
-    int generated = 0;
-    
-    // ״̬£3x3 ȫڵĸ
-    int x = 0;
-    if (SafeZone) {
-        for (int dr = -1; dr <= 1; dr++) {
-            for (int dc = -1; dc <= 1; dc++) {
-                int nr = r + dr;
-                int nc = c + dc;
-                if (nr >= 0 && nr < rows && nc >= 0 && nc < cols) {
-                    x++;
-                }
+// 每块至少这么多格子才值得交给线程池
+#define PARALLEL_MIN_CELLS (1 << 16)
+
+static int RowGrain(int cols) {
+    return max(1, PARALLEL_MIN_CELLS / max(cols, 1));
+}
+
+// 超过这个格子数的棋盘生成完就交还候选数组与位棋盘。候选数组每格 4 字节，2^28 格的棋盘要 1 GB，
+// 不能一直挂在线程上；这么大的棋盘重新分配一次的开销与生成本身相比可以忽略
+#define SCRATCH_KEEP_CELLS (1 << 20)
+
+int buildCandidates(const DynamicGeometry& g, int r, int c, int radius, int* candidates) {
+    const int rows = g.rows(), cols = g.cols(), stride = g.stride();
+    // 受保护的行和列（radius < 0 时为空）
+    const int zr0 = radius < 0 ? 0 : max(r - radius, 0), zr1 = radius < 0 ? -1 : min(r + radius, rows - 1);
+    const int zc0 = radius < 0 ? 0 : max(c - radius, 0), zc1 = radius < 0 ? -1 : min(c + radius, cols - 1);
+    const int zoneCols = zc1 - zc0 + 1;
+
+    // 第 i 行的候选从 i * cols 减去它之前被排除的格子数处开始，各行互不重叠
+    parallelFor(0, rows, RowGrain(cols), [&](int from, int to) {
+        for (int i = from; i < to; i++) {
+            int zoneRowsBefore = min(max(i - zr0, 0), max(zr1 - zr0 + 1, 0));
+            int* out = candidates + (size_t)i * cols - (size_t)zoneRowsBefore * zoneCols;
+            bool zoneRow = i >= zr0 && i <= zr1;
+            for (int j = 0; j < cols; j++) {
+                if (zoneRow && j >= zc0 && j <= zc1) continue;
+                *out++ = boardIndex(i, j, stride);
             }
         }
-    }
+    });
+    return rows * cols - max(zr1 - zr0 + 1, 0) * zoneCols;
+}
 
-    // жϵǰּı
-    bool protect3x3 = false;
-    bool protect1x1 = false;
-    int protectedCells = 0;
-
-    if (SafeZone) {
-        if (mineCount <= rows * cols - x) {
-            // ռ㣬 3x3 
-            protectedCells = x;
-            protect3x3 = true;
-        } else if (mineCount < rows * cols) {
-            // ռ䲻Ա 3x3Ϊֻҵ 1 
-            protectedCells = 1;
-            protect1x1 = true;
-        }
+void generateMines(int r, int c, int rows, int cols, const int mineCount, uint8_t* cells, bool SafeZone, uint64_t seed) {
+    // 三个预设尺寸走编译期定尺寸的内核，结果与下面的通用路径逐字节相同
+    if (generatePresetMines(r, c, rows, cols, mineCount, cells, SafeZone, seed)) return;
+
+    // 每个棋盘独立的随机流，同一种子在任何平台上都得到同一个棋盘
+    const int stride = boardStride(cols);
+    DynamicGeometry g = {rows, cols};
+    // 候选数组与位棋盘按线程复用：同一尺寸反复生成时不再分配内存（超过 SCRATCH_KEEP_CELLS 的除外）。
+    // 候选数组每格都会被 buildCandidates 写到，不需要先清零
+    static thread_local unique_ptr<int[]> candidates;
+    static thread_local size_t candidateCapacity = 0;
+    static thread_local Bitboard scratchBoard;
+    // 线程池里的 lambda 要引用本线程这一份，不能直接写 thread_local 变量名
+    Bitboard& bb = scratchBoard;
+    if (candidateCapacity < (size_t)rows * cols) {
+        candidates.reset(new int[(size_t)rows * cols]);
+        candidateCapacity = (size_t)rows * cols;
+    }
+    // 抽取依赖同一条随机序列，只能串行；候选构建、计数、写雷标记按行分块并行
+    int from, to;
+    drawMines(g, r, c, mineCount, SafeZone, seed, candidates.get(), from, to);
+
+    // 雷记入位棋盘，供下面批量计算周围雷数
+    bitboardInit(bb, rows, cols);
+    for (int k = from; k < to; k++) {
+        int idx = candidates[k];
+        bitboardSet(bb, idx / stride - 1, idx % stride - 1);
     }
 
-    // ʼ
-    while (generated < mineCount) {
-        // 㵱ǰжٸϷҿСĸӿԷ
-        int availableSpaces = rows * cols - protectedCells - generated;
-        if (availableSpaces <= 0) break; // ȫ۶
-
-        int mineIdx = randomInt(0, availableSpaces - 1);
-        int count = 0;
-        bool placed = false; 
-        
-        for (int i = 0; i < rows && !placed; i++) {
-            for (int j = 0; j < cols && !placed; j++) {
-                // λѾף
-                if (isMine(mine[i][j])) continue;
-
-                // øǷڱ״̬
-                bool isProtected = false;
-                if (protect3x3 && abs(i - r) <= 1 && abs(j - c) <= 1) {
-                    isProtected = true;
-                } else if (protect1x1 && i == r && j == c) {
-                    isProtected = true;
-                }
+    // 用位平面加法逐行算出周围雷数，直接写进格子数组（结果与逐格 updateAdjacentCount 相同），
+    // 再按位棋盘把本行的雷格子改成只有雷标记。每块只写自己的行和两侧哨兵
+    const uint8_t border = CELL_BORDER | CELL_REVEALED;
+    memset(cells, border, stride);
+    memset(cells + (size_t)(rows + 1) * stride, border, stride);
+    parallelFor(0, rows, RowGrain(cols), [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            uint8_t* row = cells + boardIndex(i, 0, stride);
+            row[-1] = border;
+            row[cols] = border;
+            bitboardRowCounts(bb, i, row);
+            bitboardForEachInRow(bb, i, [row](int j) { row[j] = CELL_MINE; });
+        }
+    });
 
-                // 
-                if (isProtected) continue;
+    if ((size_t)rows * cols > SCRATCH_KEEP_CELLS) {
+        candidates.reset();
+        candidateCapacity = 0;
+        vector<uint64_t>().swap(bb.bits);
+    }
+}
 
-                // ҵ mineIdx ÿո
-                if (count == mineIdx) {
-                    mine[i][j] = '*';
-                    generated++;
-                    placed = true; 
-                } else {
-                    count++; 
+bool relocateMines(int r, int c, int rows, int cols, int mineCount, uint8_t* cells, bool SafeZone, uint64_t seed) {
+    int radius = safeZoneRadius(r, c, rows, cols, mineCount, SafeZone);
+    if (radius < 0) return false;
+
+    // 与布雷用的随机流相互独立，同一种子 + 同一首次点击总得到同一个棋盘
+    BoardRng rng;
+    rngInit(rng, seed, rows, cols, mineCount, 1);
+
+    const int stride = boardStride(cols);
+    const int r0 = max(r - radius, 0), r1 = min(r + radius, rows - 1);
+    const int c0 = max(c - radius, 0), c1 = min(c + radius, cols - 1);
+
+    // 先把安全区里的雷全部拿走（保留插旗状态）
+    int moved[9];
+    int movedCount = 0;
+    for (int i = r0; i <= r1; i++) {
+        for (int j = c0; j <= c1; j++) {
+            uint8_t& cell = cells[boardIndex(i, j, stride)];
+            if (!cellIsMine(cell)) continue;
+            cell &= CELL_FLAG;
+            moved[movedCount++] = i * cols + j;
+        }
+    }
+    if (movedCount == 0) return false;
+
+    // 每颗雷均匀地落到安全区外任意一个空格上（无放回）。
+    // 先拒绝采样，空格很少时改为顺序扫描第 pick 个空格，两种方式各自都是均匀的。
+    int targets[9];
+    const int total = rows * cols;
+    for (int m = 0; m < movedCount; m++) {
+        int target = -1;
+        for (int tries = 0; tries < 64 && target < 0; tries++) {
+            int pos = (int)rngBelow(rng, (uint32_t)total);
+            int i = pos / cols, j = pos % cols;
+            if (i >= r0 && i <= r1 && j >= c0 && j <= c1) continue;
+            if (cellIsMine(cells[boardIndex(i, j, stride)])) continue;
+            target = pos;
+        }
+        if (target < 0) {
+            int freeCount = 0;
+            for (int i = 0; i < rows; i++) {
+                const uint8_t* row = cells + boardIndex(i, 0, stride);
+                for (int j = 0; j < cols; j++) freeCount += !cellIsMine(row[j]);
+            }
+            // 安全区内此时已没有雷，要从空格里扣掉
+            freeCount -= (r1 - r0 + 1) * (c1 - c0 + 1);
+            int pick = (int)rngBelow(rng, (uint32_t)freeCount);
+            for (int i = 0; i < rows && target < 0; i++) {
+                const uint8_t* row = cells + boardIndex(i, 0, stride);
+                for (int j = 0; j < cols; j++) {
+                    if (cellIsMine(row[j])) continue;
+                    if (i >= r0 && i <= r1 && j >= c0 && j <= c1) continue;
+                    if (pick-- == 0) {
+                        target = i * cols + j;
+                        break;
+                    }
                 }
             }
         }
+        uint8_t& cell = cells[boardIndex(target / cols, target % cols, stride)];
+        cell = (uint8_t)(CELL_MINE | (cell & CELL_FLAG));
+        targets[m] = target;
     }
 
-    // иӵΧ
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            updateAdjacentCount(i, j, rows, cols, mine);
+    // 只重算挪走和新放下的雷周围 3x3 内的格子
+    for (int m = 0; m < 2 * movedCount; m++) {
+        int pos = m < movedCount ? moved[m] : targets[m - movedCount];
+        int pr = pos / cols, pc = pos % cols;
+        for (int i = max(pr - 1, 0); i <= min(pr + 1, rows - 1); i++) {
+            for (int j = max(pc - 1, 0); j <= min(pc + 1, cols - 1); j++) {
+                updateAdjacentCount(i, j, cols, cells);
+            }
         }
     }
+    return true;
 }
 
-// ================= Ϸ״̬ =================
+// ================= 游戏状态管理 =================
 
 extern int rows;
 extern int cols;
 extern int mineCount;
 extern bool SafeZone;
-int** mine = NULL;
-
-void initializeGame(int r, int c, bool FirstClick) {
-    mine = new int*[rows];
-    if (!mine) exit(1);  
-
-    for (int i = 0; i < rows; i++) {
-        mine[i] = new int[cols];
-        if (!mine[i]) exit(1);
-    }
-
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            mine[i][j] = 0;
-        }
-    }
-
-    if (FirstClick) {
-        generateMines(r, c, rows, cols, mineCount, mine, SafeZone);
-    }else{
-        generateMines(-1, -1, rows, cols, mineCount, mine, false);
-    }
+extern uint64_t gameSeed;
+uint8_t* cells = NULL;
+uint64_t boardSeed = 0;
+static int totalMines = 0;      // 本局总雷数（mineCount 会随插旗变化）
+static char titleBuf[128];
+static int stride = 0;          // 带哨兵的行宽 cols + 2
+static Arena gameArena;         // 本局所有缓冲都从这里切出，跨局复用
+static OpeningIndex openings;   // 本局棋盘的空白区索引与 3BV
+static vector<int> revealed;    // 本次操作新翻开的格子，兼作展开队列，跨操作复用容量
+
+// 首次点击挪雷后，不超过这个格子数的棋盘当场重建空白区索引（只需几毫秒）
+#define OPENING_REBUILD_CELLS (1 << 18)
+// 不超过这个格子数的棋盘开局时按整盘预留展开列表，之后的翻开不再扩容
+#define REVEAL_RESERVE_CELLS (1 << 20)
+
+static inline int CellIndex(int r, int c) {
+    return boardIndex(r, c, stride);
 }
 
-void cleanupGame() {
-    cgt_clear_screen();
-    for (int i = 0; i < rows; i++) {
-        delete[] mine[i];
-    }
-    delete[] mine;
-    mine = NULL;
+// 按 boardSeed 在 cells 上布雷，不带安全区（首次点击时再由 relocateMines 挪雷）。
+// generateMines 会写满包括哨兵在内的所有格子
+void initializeGame() {
+    generateMines(-1, -1, rows, cols, totalMines, cells, false, boardSeed);
 }
 
-char** CreateMineLines(int rows, int cols) {
-    char** Mine_lines = new char*[3 * rows + 1];
-    for (int i = 0; i < 3 * rows + 1; i++) {
-        Mine_lines[i] = new char[4 * cols + 2];
-        for (int j = 0; j < 4 * cols + 1; j++) {
-            if (i % 3 == 0) {
-                Mine_lines[i][j] = ' ';
-            } else {
-                if (j % 4 == 0) {
-                    Mine_lines[i][j] = ' ';
-                } else {
-                    Mine_lines[i][j] = '*';
-                }
-            }
-        }
-        Mine_lines[i][4 * cols + 1] = '\0';
-    }
-    return Mine_lines;
+static void FormatTitle() {
+    snprintf(titleBuf, sizeof(titleBuf), "扫雷 : %dx%d , 雷数 : %d , 种子 : %llu , 剩余 : ",
+             rows, cols, totalMines, (unsigned long long)boardSeed);
 }
 
-// ================= Ϸ߼ (չ˫) =================
-
-void AutoSwitch(int x, int y, int** mine) {
-    int r = (y - 5) / 3;
-    int c = (x - 5) / 4;
-
-    if (r < 0 || r >= rows || c < 0 || c >= cols) return;
-    if (mine[r][c] < 0) return;
-
-    int val = mine[r][c];
-    mine[r][c] = -(val+1); 
-
-    cgt_print_char(' ', x - 1, y, COLOR_LIGHT_WHITE, COLOR_LIGHT_WHITE);
-    cgt_print_char(' ', x + 1, y, COLOR_LIGHT_WHITE, COLOR_LIGHT_WHITE);
-    cgt_print_char(' ', x - 1, y - 1, COLOR_LIGHT_WHITE, COLOR_LIGHT_WHITE);
-    cgt_print_char(' ', x, y - 1, COLOR_LIGHT_WHITE, COLOR_LIGHT_WHITE);
-    cgt_print_char(' ', x + 1, y - 1, COLOR_LIGHT_WHITE, COLOR_LIGHT_WHITE);
-
-    if (val > 0 && val <= 8) {
-        int color;
-        switch (val) {
-            case 1: color = COLOR_LIGHT_BLUE; break;
-            case 2: color = COLOR_LIGHT_GREEN; break;
-            case 3: color = COLOR_LIGHT_MAGENTA; break;
-            case 4: color = COLOR_MAGENTA; break;
-            case 5: color = COLOR_BLUE; break;
-            case 6: color = COLOR_LIGHT_RED; break;
-            case 7: color = COLOR_LIGHT_RED; break;
-            case 8: color = COLOR_RED; break;
-            default: color = COLOR_LIGHT_WHITE; break;
-        }
-        cgt_print_int(val, x, y, color, COLOR_LIGHT_WHITE);
-    }
-    else if (val == 0) {
-        cgt_print_char(' ', x, y, COLOR_LIGHT_WHITE, COLOR_LIGHT_WHITE);
-        AutoSwitch(x - 4, y, mine);
-        AutoSwitch(x + 4, y, mine);
-        AutoSwitch(x, y - 3, mine);
-        AutoSwitch(x, y + 3, mine);
-        AutoSwitch(x - 4, y - 3, mine);
-        AutoSwitch(x + 4, y - 3, mine);
-        AutoSwitch(x - 4, y + 3, mine);
-        AutoSwitch(x + 4, y + 3, mine);
-    }
+// 一局所需的全部字节：只有格子数组
+static size_t GameArenaBytes(int rows, int cols) {
+    return boardCellCount(rows, cols);
 }
 
-bool TryChord(int x, int y, int* userMine) {
-    int r = (y - 5) / 3;
-    int c = (x - 5) / 4;
-    if (r < 0 || r >= rows || c < 0 || c >= cols) return false;
-
-    if (mine[r][c] > 0) return false;
-
-    int realMineCount = - mine[r][c] - 1;
-
-    int flagCount = 0;
-    for (int i = -1; i <= 1; ++i) {
-        for (int j = -1; j <= 1; ++j) {
-            if (i == 0 && j == 0) continue;
-            int nr = r + i;
-            int nc = c + j;
-            if (nr >= 0 && nr < rows && nc >= 0 && nc < cols) {
-                if (userMine[nr * cols + nc] == -1) {
-                    flagCount++;
-                }
-            }
+// 开局：优先从后台池取一块现成的棋盘拷进本局缓冲；玩家指定了种子或池里暂时没有时当场生成
+static void PrepareBoard() {
+    stride = boardStride(cols);
+
+    arenaReset(gameArena, GameArenaBytes(rows, cols));
+    cells = arenaAllocArray<uint8_t>(gameArena, boardCellCount(rows, cols));
+    if (boardCellCount(rows, cols) <= REVEAL_RESERVE_CELLS) revealed.reserve((size_t)rows * cols);
+
+    // 指定了种子的局从不取池里的棋盘，也就不让后台为这个尺寸白白生成
+    if (gameSeed == 0) {
+        boardPoolConfigure(rows, cols, totalMines);
+        PooledBoard board;
+        if (boardPoolTake(-1, -1, false, board)) {
+            memcpy(cells, board.cells, boardCellCount(rows, cols));
+            boardSeed = board.seed;
+            // 缓冲立即交回，后台马上在上面生成下一块
+            boardPoolRecycle(board.cells);
+            return;
         }
     }
+    boardSeed = gameSeed != 0 ? gameSeed : rngFreshSeed();
+    initializeGame();
+}
 
-    if (flagCount == realMineCount) {
-        for (int i = -1; i <= 1; ++i) {
-            for (int j = -1; j <= 1; ++j) {
-                if (i == 0 && j == 0) continue;
-                int nr = r + i;
-                int nc = c + j;
-
-                if (nr >= 0 && nr < rows && nc >= 0 && nc < cols) {
-                    if (userMine[nr * cols + nc] == -1 || mine[nr][nc] < 0) continue;
-
-                    int sx = 5 + nc * 4;
-                    int sy = 5 + nr * 3;
-
-                    if (mine[nr][nc] == '*') {
-                        play_bomb_sound();
-                        cgt_print_char('*', sx, sy, COLOR_BLACK, COLOR_MAGENTA);
-                        cgt_print_char(' ', sx-1, sy, COLOR_MAGENTA, COLOR_MAGENTA);
-                        cgt_print_char(' ', sx+1, sy, COLOR_MAGENTA, COLOR_MAGENTA);
-                        cgt_print_char(' ', sx-1, sy-1, COLOR_MAGENTA, COLOR_MAGENTA);
-                        cgt_print_char(' ', sx, sy-1, COLOR_MAGENTA, COLOR_MAGENTA);
-                        cgt_print_char(' ', sx+1, sy-1, COLOR_MAGENTA, COLOR_MAGENTA);
-                        cgt_print_str("Ϸȵˣ˳", 1, 2, COLOR_RED, COLOR_BLACK);
-                        return true;
-                    } else {
-                        AutoSwitch(sx, sy, mine);
-                    }
-                }
-            }
-        }
+// 首次点击：把安全区里的雷挪到区外的随机空格，只改动受影响的几格，与棋盘大小无关。
+// 挪动用的随机数也由 boardSeed 派生，“种子 + 首次点击位置”仍唯一确定棋盘，
+// 且结果在所有满足安全区的棋盘上均匀分布，与直接按安全区规则生成相同。
+// 挪过雷后空白区索引随之失效：小棋盘当场重建，大棋盘改为逐格展开，3BV 到结算时再算
+static void ApplyFirstClick(int r, int c) {
+    if (!relocateMines(r, c, rows, cols, totalMines, cells, SafeZone, boardSeed)) return;
+    if (boardCellCount(rows, cols) <= OPENING_REBUILD_CELLS) {
+        openingIndexBuild(openings, cells, rows, cols);
+    } else {
+        openingIndexInvalidate(openings);
     }
-    return false;
 }
 
-void UpdateHover(int x, int y, int& lastR, int& lastC, int** internalMine, int* userMine, int rows, int cols, char** Mine_lines) {
-    if (x < 3 || x > 3 + cols * 4 || y < 3 || y > 3 + rows * 3) {
-        if (lastR != -1) {
-            if (internalMine[lastR][lastC] >= 0) {
-                int sx = 5 + lastC * 4;
-                int sy = 5 + lastR * 3;
-                if (userMine[lastR * cols + lastC] == -1) {
-                    cgt_print_char('F', sx, sy, COLOR_BLACK, COLOR_RED);
-                    cgt_print_char(' ', sx-1, sy, COLOR_RED, COLOR_RED);
-                    cgt_print_char(' ', sx+1, sy, COLOR_RED, COLOR_RED);
-                    cgt_print_char(' ', sx-1, sy-1, COLOR_RED, COLOR_RED);
-                    cgt_print_char(' ', sx, sy-1, COLOR_RED, COLOR_RED);
-                    cgt_print_char(' ', sx+1, sy-1, COLOR_RED, COLOR_RED);
-                } else {
-                    cgt_print_char(' ', sx, sy, COLOR_YELLOW, COLOR_YELLOW);
-                    cgt_print_char(' ', sx-1, sy, COLOR_YELLOW, COLOR_YELLOW);
-                    cgt_print_char(' ', sx+1, sy, COLOR_YELLOW, COLOR_YELLOW);
-                    cgt_print_char(' ', sx-1, sy-1, COLOR_YELLOW, COLOR_YELLOW);
-                    cgt_print_char(' ', sx, sy-1, COLOR_YELLOW, COLOR_YELLOW);
-                    cgt_print_char(' ', sx+1, sy-1, COLOR_YELLOW, COLOR_YELLOW);
-                }
-            }
-            lastR = -1;
-            lastC = -1;
-            return;
-        } else {
-            return;
-        }
-    }
-        
-    if (Mine_lines[(y - 3)][(x - 3)] == '*') {
-        while (Mine_lines[(y - 4)][(x - 3)] == ' ' || Mine_lines[(y - 3)][(x - 4)] == ' ' || Mine_lines[(y - 3)][(x - 2)] == ' '){
-            if (Mine_lines[(y - 4)][(x - 3)] == ' ') {                        
-                y = y + 1;
-            }else if (Mine_lines[(y - 3)][(x - 4)] == ' ') {
-                x = x + 1;
-            }else if (Mine_lines[(y - 3)][(x - 2)] == ' ') {
-                x = x - 1;
-            }
-        }
-    }
+void cleanupGame() {
+    cgt_clear_screen();
+    // 格子数组属于 gameArena，留给下一局复用
+    cells = NULL;
+}
 
-    bool isInside = Mine_lines[(y - 3)][(x - 3)] == '*';
-    int r = (y - 5) / 3;
-    int c = (x - 5) / 4;
+void releaseGameBuffers() {
+    arenaRelease(gameArena);
+}
 
-    if (isInside && internalMine[r][c] < 0) {
-        isInside = false;
-    }
+// ================= 游戏核心逻辑 (展开) =================
 
-    if (isInside && r == lastR && c == lastC) return;
-    if (!isInside && lastR == -1) return;
-
-    if (lastR != -1) {
-        if (internalMine[lastR][lastC] >= 0) {
-            int sx = 5 + lastC * 4;
-            int sy = 5 + lastR * 3;
-            if (userMine[lastR * cols + lastC] == -1) {
-                cgt_print_char('F', sx, sy, COLOR_BLACK, COLOR_RED);
-                cgt_print_char(' ', sx-1, sy, COLOR_RED, COLOR_RED);
-                cgt_print_char(' ', sx+1, sy, COLOR_RED, COLOR_RED);
-                cgt_print_char(' ', sx-1, sy-1, COLOR_RED, COLOR_RED);
-                cgt_print_char(' ', sx, sy-1, COLOR_RED, COLOR_RED);
-                cgt_print_char(' ', sx+1, sy-1, COLOR_RED, COLOR_RED);
-            } else {
-                cgt_print_char(' ', sx, sy, COLOR_YELLOW, COLOR_YELLOW);
-                cgt_print_char(' ', sx-1, sy, COLOR_YELLOW, COLOR_YELLOW);
-                cgt_print_char(' ', sx+1, sy, COLOR_YELLOW, COLOR_YELLOW);
-                cgt_print_char(' ', sx-1, sy-1, COLOR_YELLOW, COLOR_YELLOW);
-                cgt_print_char(' ', sx, sy-1, COLOR_YELLOW, COLOR_YELLOW);
-                cgt_print_char(' ', sx+1, sy-1, COLOR_YELLOW, COLOR_YELLOW);
-            }
-        }
-        lastR = -1;
-        lastC = -1;
-    }
+// 翻开 idx：0 雷格子直接取索引里现成的整片空白区，其余情况逐格展开（大棋盘按 8x8 小块展开）
+static void RevealCell(int idx) {
+    if (openingIndexReveal(openings, cells, idx, revealed)) return;
+    revealFrom(cells, rows, cols, idx, revealed);
+}
 
-    if (isInside) {
-        int sx = 5 + c * 4;
-        int sy = 5 + r * 3;
-        
-        if (userMine[r * cols + c] == -1) {
-            cgt_print_char('F', sx, sy, COLOR_BLACK, COLOR_LIGHT_RED);
-            cgt_print_char(' ', sx-1, sy, COLOR_LIGHT_RED, COLOR_LIGHT_RED);
-            cgt_print_char(' ', sx+1, sy, COLOR_LIGHT_RED, COLOR_LIGHT_RED);
-            cgt_print_char(' ', sx-1, sy-1, COLOR_LIGHT_RED, COLOR_LIGHT_RED);
-            cgt_print_char(' ', sx, sy-1, COLOR_LIGHT_RED, COLOR_LIGHT_RED);
-            cgt_print_char(' ', sx+1, sy-1, COLOR_LIGHT_RED, COLOR_LIGHT_RED);
-        } else {
-            cgt_print_char(' ', sx, sy, COLOR_LIGHT_YELLOW, COLOR_LIGHT_YELLOW);
-            cgt_print_char(' ', sx-1, sy, COLOR_LIGHT_YELLOW, COLOR_LIGHT_YELLOW);
-            cgt_print_char(' ', sx+1, sy, COLOR_LIGHT_YELLOW, COLOR_LIGHT_YELLOW);
-            cgt_print_char(' ', sx-1, sy-1, COLOR_LIGHT_YELLOW, COLOR_LIGHT_YELLOW);
-            cgt_print_char(' ', sx, sy-1, COLOR_LIGHT_YELLOW, COLOR_LIGHT_YELLOW);
-            cgt_print_char(' ', sx+1, sy-1, COLOR_LIGHT_YELLOW, COLOR_LIGHT_YELLOW);
-        }
-        lastR = r;
-        lastC = c;
-    }
+// 结算时的 3BV；索引已失效时按当前棋盘重建一次（翻开标记不影响结果），棋盘过大时为 -1
+static int BoardThreeBV() {
+    if (!openings.valid) openingIndexBuild(openings, cells, rows, cols);
+    return openings.bbbv;
 }
 
-// ================= Ϸ߼ =================
-
-/**
- * ̱
- */
-void DrawBoard(char** Mine_lines, int nlines) {
-    const long offset_x = 3;
-    const long offset_y = 3;
-
-    for (long row = 0; row < nlines; row++) {
-        const char* line = Mine_lines[row];
-        for (long col = 0; line[col] != '\0'; col++) {
-            if (line[col] == '*'){
-                cgt_print_char(' ', col + offset_x, row + offset_y, COLOR_YELLOW, COLOR_YELLOW);
-            }else{
-                cgt_print_char(' ', col + offset_x, row + offset_y, COLOR_WHITE, COLOR_WHITE);
-            }
+// ================= 接入视口 =================
+// 普通棋盘与超大稀疏棋盘、无尽模式共用 view.cpp 的视口：棋盘放得下时整块显示，
+// 放不下时只绘制视口里的格子，每帧的输出与棋盘大小无关
+
+static int64_t revealedCells = 0;   // 本局已翻开的格子数
+static int flagsOnMines = 0;        // 插在雷上的旗数，等于总雷数即获胜
+static time_t startTime = 0;
+
+static uint8_t DenseCell(int64_t x, int64_t y) { return cells[CellIndex((int)y, (int)x)]; }
+
+// 新翻开的下标换成视口坐标交给视口绘制
+static int DenseReveal(int64_t x, int64_t y, vector<WorldPos>& out, vector<WorldPos>& unflagged) {
+    RevealCell(CellIndex((int)y, (int)x));
+    for (size_t i = 0; i < revealed.size(); i++) {
+        WorldPos p = {revealed[i] % stride - 1, revealed[i] / stride - 1};
+        // 翻开了插错的旗（展开只经过非雷格子）：旗收回，剩余雷数随之恢复，视口据此修正小地图
+        uint8_t& cell = cells[revealed[i]];
+        if (cellIsFlagged(cell)) {
+            cell &= ~CELL_FLAG;
+            mineCount++;
+            unflagged.push_back(p);
         }
+        out.push_back(p);
     }
+    int n = (int)revealed.size();
+    revealedCells += n;
+    revealed.clear();
+    return n;
 }
 
-/**
- * Ϸѭ¼ʤж
- * userMine: û״̬ (һάָ)
- * Mine_lines: ַ
- * titleStr: 
- * winTarget: ʤĲ (ʼ)
- */
-void ProcessGameLoop(int* userMine, char** Mine_lines, const char* titleStr, int winTarget) {
-    // 껺
-    while (cgt_has_mouse()) {
-        int x, y, button, event;
-        cgt_get_mouse(x, y, button, event);
-    }
-    
-    int lastR = -1;
-    int lastC = -1;
-    int flag = 0;
+static bool DenseToggleFlag(int64_t x, int64_t y) {
+    uint8_t& cell = cells[CellIndex((int)y, (int)x)];
+    if (cellIsRevealed(cell)) return false;
+    cell ^= CELL_FLAG;
+    const int delta = cellIsFlagged(cell) ? 1 : -1;
+    mineCount -= delta;
+    if (cellIsMine(cell)) flagsOnMines += delta;
+    return cellIsFlagged(cell);
+}
 
-    //¼Ϸʼʱ
-    time_t startTime = time(nullptr);
-    bool FirstClick = true;
+static void DenseFirstClick(int64_t x, int64_t y) { ApplyFirstClick((int)y, (int)x); }
+static bool DenseWon() { return flagsOnMines == totalMines; }
 
-    while (true) {
-        cgt_gotoxy(0, 0);
-        cgt_print_str(titleStr, 1, 1, COLOR_WHITE, COLOR_BLACK);
-        cgt_print_int(mineCount);
-        cgt_print_str("  "); // ַܲ
-
-        // 㲢ʾʱ
-        // time(nullptr) ȡǰʱȥʼʱ伴Ϊ
-        int elapsed = (int)(time(nullptr) - startTime);
-        cgt_print_str("ʱ : ", -1, -1, COLOR_WHITE, COLOR_BLACK);
-        cgt_print_int(elapsed, -1, -1, COLOR_LIGHT_CYAN, COLOR_BLACK); // ʹɫʱ
-        cgt_print_str("     "); // ոֱֹʱ
-
-        if (!cgt_has_mouse()) {
-            cgt_msleep(50);
-            continue;
-        }
+static void DenseTitle(char* buf, size_t size) {
+    snprintf(buf, size, "%s%d  用时 : %d 秒    ", titleBuf, mineCount, (int)(time(nullptr) - startTime));
+}
 
-        int x, y, button, event;
-        cgt_get_mouse(x, y, button, event);
-        
-        // ͨ Hover 
-        UpdateHover(x, y, lastR, lastC, mine, userMine, rows, cols, Mine_lines);
-        
-        // ߽
-        if (x < 3 || x > 3 + cols * 4 || y < 3 || y > 3 + rows * 3) {
-            continue;
-        }
-        
-        // ߼ (λӳ䵽ɨ)
-        if (Mine_lines[(y - 3)][(x - 3)] == '*') {
-            while (Mine_lines[(y - 4)][(x - 3)] == ' ' || Mine_lines[(y - 3)][(x - 4)] == ' ' || Mine_lines[(y - 3)][(x - 2)] == ' '){
-                if (Mine_lines[(y - 4)][(x - 3)] == ' ') {                        
-                    y = y + 1;
-                }else if (Mine_lines[(y - 3)][(x - 4)] == ' ') {
-                    x = x + 1;
-                }else if (Mine_lines[(y - 3)][(x - 2)] == ' ') {
-                    x = x - 1;
-                }
-            }
-        }
+// 胜利时显示最终用时与 3BV
+static void DenseWin(char* buf, size_t size) {
+    int len = snprintf(buf, size, "游戏结束！你成功清除所有雷！最终用时: %d 秒", (int)(time(nullptr) - startTime));
+    int bbbv = BoardThreeBV();
+    if (bbbv >= 0) len += snprintf(buf + len, size - len, " , 3BV : %d", bbbv);
+    snprintf(buf + len, size - len, "。按任意键退出。");
+}
 
-        int r = (y-5)/3;
-        int c = (x-5)/4;
+static const ViewBoard DENSE_VIEW = {
+    0, 0, &revealedCells, DenseCell, DenseCell, DenseReveal, DenseToggleFlag,
+    DenseFirstClick, DenseWon, NULL, DenseTitle, DenseWin,
+};
 
-        if (event == MOUSE_CLICK) {
-            if (Mine_lines[(y - 3)][(x - 3)] == '*'){
-                if (FirstClick) {
-                    initializeGame(r, c, FirstClick);
-                    FirstClick = false;
-                }
-            }
-            if (button == MOUSE_BUTTON_LEFT) {
-                if (Mine_lines[(y - 3)][(x - 3)] == '*') {
-                    // ж
-                    if (mine[r][c] == '*'){
-                        play_bomb_sound();
-                        cgt_print_char('*', x, y, COLOR_BLACK, COLOR_MAGENTA);
-                        cgt_print_char(' ', x-1, y, COLOR_MAGENTA, COLOR_MAGENTA);
-                        cgt_print_char(' ', x+1, y, COLOR_MAGENTA, COLOR_MAGENTA);
-                        cgt_print_char(' ', x-1, y-1, COLOR_MAGENTA, COLOR_MAGENTA);
-                        cgt_print_char(' ', x, y-1, COLOR_MAGENTA, COLOR_MAGENTA);
-                        cgt_print_char(' ', x+1, y-1, COLOR_MAGENTA, COLOR_MAGENTA);
-                        cgt_print_str("Ϸȵˣ˳", 1, 2, COLOR_RED, COLOR_BLACK);
-                        wait_for_enter();
-                        cleanupGame();
-                        return;
-                    }else{                                          
-                        AutoSwitch(x, y, mine);
-                        continue;
-                    }
-                }
-            } else if (button == MOUSE_BUTTON_RIGHT) {
-                if (Mine_lines[(y - 3)][(x - 3)] == '*') {
-                    
-                    int idx = r * cols + c; // һά
-
-                    // ߼
-                    if (userMine[idx] == 0 && (mine[r][c] >= 0 || mine[r][c] == '*')){
-                        userMine[idx] = -1;
-                        cgt_print_char('F', x, y, COLOR_BLACK, COLOR_RED);
-                        cgt_print_char(' ', x-1, y, COLOR_RED, COLOR_RED);
-                        cgt_print_char(' ', x+1, y, COLOR_RED, COLOR_RED);
-                        cgt_print_char(' ', x-1, y-1, COLOR_RED, COLOR_RED);
-                        cgt_print_char(' ', x, y-1, COLOR_RED, COLOR_RED);
-                        cgt_print_char(' ', x+1, y-1, COLOR_RED, COLOR_RED);
-                        mineCount--;
-                        if (mine[r][c] == '*'){
-                            flag++;
-                        }
-                        continue;
-                    }
-                    // ȡ߼
-                    else if(userMine[idx] == -1 && (mine[r][c] >= 0 || mine[r][c] == '*')){
-                        userMine[idx] = 0;
-                        cgt_print_char(' ', x, y, COLOR_YELLOW, COLOR_YELLOW);
-                        cgt_print_char(' ', x-1, y, COLOR_YELLOW, COLOR_YELLOW);
-                        cgt_print_char(' ', x+1, y, COLOR_YELLOW, COLOR_YELLOW);
-                        cgt_print_char(' ', x-1, y-1, COLOR_YELLOW, COLOR_YELLOW);
-                        cgt_print_char(' ', x, y-1, COLOR_YELLOW, COLOR_YELLOW);
-                        cgt_print_char(' ', x+1, y-1, COLOR_YELLOW, COLOR_YELLOW);
-                        mineCount++;
-                        if (mine[r][c] == '*'){
-                            flag--;
-                        }
-                        continue;
-                    }
-                }
-            }
-        } else if (event == MOUSE_DOUBLECLICK && button == MOUSE_BUTTON_LEFT){
-            if (Mine_lines[(y - 3)][(x - 3)] == '*') {
-                if (TryChord(x, y, userMine)){
-                    wait_for_enter();
-                    cleanupGame();
-                    return;
-                }
-            }
-        }
+// ================= 主入口函数 =================
 
-        if (flag == winTarget){
-            play_victory_sound();
-            //ʤʱʾʱ 
-            int finalTime = (int)(time(nullptr) - startTime);
-            cgt_print_str("Ϸɹףʱ: ", 1, 2, COLOR_GREEN, COLOR_BLACK);
-            cgt_print_int(finalTime, -1, -1, COLOR_LIGHT_CYAN, COLOR_BLACK);
-            cgt_print_str(" 롣˳");
-            
-            wait_for_enter();
-            cleanupGame();
-            return;
-        }
+void Game() {
+    // 超大的低密度棋盘改用稀疏存储，在可滚动的视口里玩
+    if (boardPrefersSparse(rows, cols, mineCount)) {
+        SparseGame();
+        return;
     }
-}
-
-// ================= ں =================
 
-void Game() {
-    initializeGame(0, 0, false);
-    cgt_clear_screen();
-    
-    char** Mine_lines = CreateMineLines(rows, cols);
-    long nlines = 3 * rows + 1;
-    DrawBoard(Mine_lines, nlines);
-
-    
-    int* userMine = new int[rows * cols];
-    for (int i = 0; i < rows * cols; ++i) userMine[i] = 0;
-
-    char titleBuf[128];
-    snprintf(titleBuf, sizeof(titleBuf), "ɨ : %dx%d ,  : %d , ʣ : ", rows, cols, mineCount);
-
-    ProcessGameLoop(userMine, Mine_lines, titleBuf, mineCount);
-    for (long i = 0; i < nlines; ++i) delete[] Mine_lines[i];
-    delete[] Mine_lines;
-    delete[] userMine;
-    return;
-}
\ No newline at end of file
+    // 棋盘来自后台池或当场生成，种子显示在标题栏以便复现
+    totalMines = mineCount;
+    PrepareBoard();
+    openingIndexBuild(openings, cells, rows, cols);
+    FormatTitle();
+
+    revealedCells = 0;
+    flagsOnMines = 0;
+    //记录游戏开始的时间戳
+    startTime = time(nullptr);
+    viewCameraX = 0;
+    viewCameraY = 0;
+
+    ViewBoard board = DENSE_VIEW;
+    board.rows = rows;
+    board.cols = cols;
+    viewRun(board);
+    cleanupGame();
+}
@@ -0,0 +1,96 @@
+#include "cgt.h"
+#include "game.h"
+#include "view.h"
+#include "chunk_world.h"
+#include "sparse_board.h"
+#include "rng.h"
+#include <cstdio>
+#include <vector>
+
+using namespace std;
+
+// ================= 视口模式：无尽模式与超大稀疏棋盘 =================
+// 两种棋盘都通过 ViewBoard 接入 view.cpp 的视口，这里只负责棋盘本身。
+
+// 视口所在区块外再保留几圈区块不换出
+#define VIEW_KEEP_CHUNKS 1
+
+// ================= 无尽模式 =================
+
+static ChunkWorld world;
+
+static uint8_t WorldPeek(int64_t x, int64_t y) { return worldPeek(world, x, y); }
+static uint8_t WorldCell(int64_t x, int64_t y) { return worldCell(world, x, y); }
+static int WorldReveal(int64_t x, int64_t y, vector<WorldPos>& revealed, vector<WorldPos>&) {
+    return worldReveal(world, x, y, revealed);
+}
+static bool WorldToggleFlag(int64_t x, int64_t y) { return worldToggleFlag(world, x, y); }
+
+// 视口附近的区块留在内存里，其余的按最久未用换出
+static void WorldSettle() {
+    worldEvict(world,
+               worldChunkOf(viewCameraX) - VIEW_KEEP_CHUNKS, worldChunkOf(viewCameraY) - VIEW_KEEP_CHUNKS,
+               worldChunkOf(viewCameraX + viewCols - 1) + VIEW_KEEP_CHUNKS,
+               worldChunkOf(viewCameraY + viewRows - 1) + VIEW_KEEP_CHUNKS);
+}
+
+static void WorldTitle(char* buf, size_t size) {
+    snprintf(buf, size, "无尽模式 : 种子 : %llu , 位置 : (%lld, %lld) , 已翻开 : %lld , 区块 : %d / %d        ",
+             (unsigned long long)world.seed, (long long)viewCameraX, (long long)viewCameraY,
+             (long long)world.revealedCount, (int)world.active.size(), (int)world.compact.size());
+}
+
+static const ViewBoard WORLD_VIEW = {
+    0, 0, &world.revealedCount, WorldPeek, WorldCell, WorldReveal, WorldToggleFlag, NULL, NULL, WorldSettle, WorldTitle, NULL,
+};
+
+void InfiniteGame() {
+    worldInit(world, rngFreshSeed());
+    viewCameraX = -(viewCompact ? VIEW_COMPACT_COLS : VIEW_COLS) / 2;
+    viewCameraY = -(viewCompact ? VIEW_COMPACT_ROWS : VIEW_ROWS) / 2;
+
+    // 原点周围没有雷，开局直接翻开这片空白区
+    vector<WorldPos> opening;
+    worldReveal(world, 0, 0, opening);
+
+    viewRun(WORLD_VIEW);
+    worldRelease(world);
+}
+
+// ================= 超大稀疏棋盘 =================
+
+static SparseBoard sparse;
+
+static uint8_t SparsePeek(int64_t x, int64_t y) { return sparseCell(sparse, y, x); }
+// 稀疏棋盘翻开后旗仍留在格子上，不收回
+static int SparseRevealAt(int64_t x, int64_t y, vector<WorldPos>& revealed, vector<WorldPos>&) {
+    return sparseReveal(sparse, y, x, revealed);
+}
+static bool SparseToggleFlagAt(int64_t x, int64_t y) { return sparseToggleFlag(sparse, y, x); }
+static void SparseFirstClick(int64_t x, int64_t y) { sparseRelocate(sparse, y, x, SafeZone, boardSeed); }
+static bool SparseWon() { return sparse.revealedCount == sparse.rows * sparse.cols - sparse.mineCount; }
+
+static void SparseTitle(char* buf, size_t size) {
+    snprintf(buf, size, "扫雷 : %lldx%lld , 雷数 : %lld , 种子 : %llu , 视口 : 第 %lld 行 , 第 %lld 列 , 内存 : %.1f MB        ",
+             (long long)sparse.rows, (long long)sparse.cols, (long long)sparse.mineCount,
+             (unsigned long long)boardSeed, (long long)viewCameraY + 1, (long long)viewCameraX + 1,
+             sparseBytes(sparse) / 1048576.0);
+}
+
+static const ViewBoard SPARSE_VIEW = {
+    0, 0, &sparse.revealedCount, SparsePeek, SparsePeek, SparseRevealAt, SparseToggleFlagAt,
+    SparseFirstClick, SparseWon, NULL, SparseTitle, NULL,
+};
+
+void SparseGame() {
+    boardSeed = gameSeed != 0 ? gameSeed : rngFreshSeed();
+    sparseGenerate(sparse, rows, cols, mineCount, boardSeed);
+    viewCameraX = 0;
+    viewCameraY = 0;
+
+    ViewBoard board = SPARSE_VIEW;
+    board.rows = sparse.rows;
+    board.cols = sparse.cols;
+    viewRun(board);
+    sparseRelease(sparse);
+}
@@ -0,0 +1,140 @@
+#include "openings.h"
+#include "board.h"
+
+static inline bool IsZeroCell(uint8_t cell) {
+    return (cell & (CELL_MINE | CELL_BORDER | CELL_COUNT_MASK)) == 0;
+}
+
+static inline bool IsNumberCell(uint8_t cell) {
+    return !(cell & (CELL_MINE | CELL_BORDER)) && (cell & CELL_COUNT_MASK) != 0;
+}
+
+// 路径减半，根始终是集合里最小的下标
+static inline int FindRoot(std::vector<int>& parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+bool openingIndexBuild(OpeningIndex& index, const uint8_t* cells, int rows, int cols) {
+    const size_t total = boardCellCount(rows, cols);
+    if (total > OPENING_INDEX_MAX_CELLS) {
+        openingIndexInvalidate(index);
+        return false;
+    }
+
+    const int stride = boardStride(cols);
+    int offsets[8];
+    for (int k = 0; k < 8; k++) offsets[k] = neighbourOffset(k, stride);
+
+    // 1. 并查集：按行扫描，只需与已扫过的 4 个邻格（左上、上、右上、左）合并
+    std::vector<int>& parent = index.scratch;
+    parent.resize(total);
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            int idx = boardIndex(i, j, stride);
+            if (!IsZeroCell(cells[idx])) continue;
+            parent[idx] = idx;
+            for (int k = 0; k < 4; k++) {
+                int n = idx + offsets[k];
+                if (!IsZeroCell(cells[n])) continue;
+                int a = FindRoot(parent, idx);
+                int b = FindRoot(parent, n);
+                if (a < b) parent[b] = a;
+                else if (b < a) parent[a] = b;
+            }
+        }
+    }
+
+    // 2. 按扫描顺序给每个区编号；根是区内最小下标，总比区内其他格子先编号。
+    //    同时数出每个区的 0 雷格子数
+    index.region.assign(total, -1);
+    index.start.clear();
+    // 预留容量，同一尺寸的后续对局不再扩容：不同空白区的 0 雷格子互不相邻，
+    // 区数不超过 ceil(rows/2) * ceil(cols/2)；order 与 members 按格子总数预留，数字格同属几个区的情况很少
+    index.start.reserve((size_t)((rows + 1) / 2) * ((cols + 1) / 2) + 1);
+    index.order.reserve(total);
+    index.members.reserve(total);
+    int regions = 0;
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            int idx = boardIndex(i, j, stride);
+            if (!IsZeroCell(cells[idx])) continue;
+            int root = FindRoot(parent, idx);
+            if (root == idx) {
+                index.region[idx] = regions++;
+                index.start.push_back(0);
+            } else {
+                index.region[idx] = index.region[root];
+            }
+            index.start[index.region[idx]]++;
+        }
+    }
+
+    // 3. 0 雷格子按区排好（计数排序），存进 order
+    int zeros = 0;
+    for (int k = 0; k < regions; k++) {
+        int n = index.start[k];
+        index.start[k] = zeros;
+        zeros += n;
+    }
+    index.order.resize(zeros);
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            int idx = boardIndex(i, j, stride);
+            if (IsZeroCell(cells[idx])) index.order[index.start[index.region[idx]]++] = idx;
+        }
+    }
+
+    // 4. 逐区写出 members：先是区内 0 雷格子，再是它们邻接的数字格。
+    //    一个区处理完才轮到下一个，所以用 stamp 记住数字格最后归入的区就能去重
+    std::vector<int>& stamp = index.scratch;
+    stamp.assign(total, -1);
+    index.members.clear();
+    int zeroBegin = 0;
+    for (int k = 0; k < regions; k++) {
+        int zeroEnd = index.start[k];
+        index.start[k] = (int)index.members.size();
+        for (int z = zeroBegin; z < zeroEnd; z++) {
+            int idx = index.order[z];
+            index.members.push_back(idx);
+            for (int d = 0; d < 8; d++) {
+                int n = idx + offsets[d];
+                if (!IsNumberCell(cells[n]) || stamp[n] == k) continue;
+                stamp[n] = k;
+                index.members.push_back(n);
+            }
+        }
+        zeroBegin = zeroEnd;
+    }
+    index.start.push_back((int)index.members.size());
+
+    // 不与任何空白区相邻的数字格各需单独点一次
+    int isolated = 0;
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            int idx = boardIndex(i, j, stride);
+            isolated += IsNumberCell(cells[idx]) && stamp[idx] < 0;
+        }
+    }
+
+    index.valid = true;
+    index.bbbv = regions + isolated;
+    return true;
+}
+
+bool openingIndexReveal(const OpeningIndex& index, uint8_t* cells, int idx, std::vector<int>& revealed) {
+    if (!index.valid || (cells[idx] & CELL_REVEALED)) return false;
+    int id = index.region[idx];
+    if (id < 0) return false;
+
+    for (int m = index.start[id]; m < index.start[id + 1]; m++) {
+        int cell = index.members[m];
+        if (cells[cell] & CELL_REVEALED) continue;
+        cells[cell] |= CELL_REVEALED;
+        revealed.push_back(cell);
+    }
+    return true;
+}
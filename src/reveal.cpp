@@ -0,0 +1,211 @@
+#include "reveal.h"
+#include "board.h"
+#include "bitboard.h"
+#include "board_fixed.h"
+#include "thread_pool.h"
+#include <cstring>
+
+int revealFlood(uint8_t* cells, int stride, int start, std::vector<int>& revealed) {
+    // 展开只用到行宽，行数不影响邻格偏移
+    SquareTopology<DynamicGeometry> t = {{0, stride - 2}};
+    return topologyReveal(t, cells, start, revealed);
+}
+
+// ================= 按 8x8 小块展开 =================
+
+// 块内掩码第 i * 8 + j 位对应块内第 i 行第 j 列
+#define TILE_NOT_COL0 0xFEFEFEFEFEFEFEFEull
+#define TILE_NOT_COL7 0x7F7F7F7F7F7F7F7Full
+#define TILE_COL0 0x0101010101010101ull
+#define TILE_COL7 0x8080808080808080ull
+#define TILE_HIGH_BITS 0x8080808080808080ull
+#define TILE_LOW_BITS 0x0101010101010101ull
+// 块内越出棋盘的位置按哨兵格处理
+#define TILE_PAD_WORD 0xA0A0A0A0A0A0A0A0ull
+
+// 待处理的块，cand 为这一块里需要翻开的候选格
+struct TileWork {
+    int tileRow;
+    int tileCol;
+    uint64_t cand;
+};
+
+// 掩码向 8 个方向各扩一格（不跨块）
+static inline uint64_t TileDilate(uint64_t m) {
+    uint64_t h = m | ((m << 1) & TILE_NOT_COL0) | ((m >> 1) & TILE_NOT_COL7);
+    return h | (h << 8) | (h >> 8);
+}
+
+// 8 个字节的最低位收成 8 位
+static inline uint64_t TileGather(uint64_t w) {
+    return ((w & TILE_LOW_BITS) * 0x0102040810204080ull) >> 56;
+}
+
+// 8 位展开成 8 个字节的最低位
+static inline uint64_t TileSpread(uint64_t b) {
+    uint64_t x = (b * TILE_LOW_BITS) & 0x8040201008040201ull;
+    return ((x + 0x7F7F7F7F7F7F7F7Full) >> 7) & TILE_LOW_BITS;
+}
+
+int revealTiles(uint8_t* cells, int rows, int cols, int start, std::vector<int>& revealed) {
+    if (cells[start] & (CELL_REVEALED | CELL_MINE)) return 0;
+
+    const int height = rows + 2;
+    const int width = boardStride(cols);
+    const int tileRows = (height + 7) / 8;
+    const int tileCols = (width + 7) / 8;
+
+    static thread_local std::vector<TileWork> work;
+    work.clear();
+    TileWork first = {start / width / 8, start % width / 8, 0};
+    first.cand = 1ull << ((start / width % 8) * 8 + start % width % 8);
+    work.push_back(first);
+
+    const size_t before = revealed.size();
+    while (!work.empty()) {
+        TileWork item = work.back();
+        work.pop_back();
+
+        // 读出整块；右侧、下侧不满 8 格的块按哨兵补齐
+        const int r0 = item.tileRow * 8, c0 = item.tileCol * 8;
+        const int validRows = height - r0 < 8 ? height - r0 : 8;
+        const int validCols = width - c0 < 8 ? width - c0 : 8;
+        uint8_t* base = cells + (size_t)r0 * width + c0;
+        uint64_t words[8];
+        uint64_t zero = 0, blocked = 0;
+        for (int i = 0; i < 8; i++) {
+            words[i] = TILE_PAD_WORD;
+            if (i < validRows) memcpy(&words[i], base + (size_t)i * width, validCols);
+            // 雷数与雷标记都为 0 即 0 雷格；字节不超过 0x1F，加 0x7F 不会进位到相邻字节
+            uint64_t low = words[i] & 0x1F1F1F1F1F1F1F1Full;
+            uint64_t nonZero = ((low + 0x7F7F7F7F7F7F7F7Full) & TILE_HIGH_BITS) >> 7;
+            zero |= TileGather(~nonZero) << (8 * i);
+            blocked |= TileGather((words[i] >> 5) | (words[i] >> 4)) << (8 * i);
+        }
+
+        uint64_t fresh = item.cand & ~blocked;
+        if (!fresh) continue;
+
+        // 块内扩散：新翻开的 0 雷格再向外扩一圈，直到没有新格子
+        uint64_t opened = 0, expanded = 0;
+        while (fresh) {
+            opened |= fresh;
+            blocked |= fresh;
+            uint64_t z = fresh & zero;
+            expanded |= z;
+            fresh = TileDilate(z) & ~blocked;
+        }
+
+        for (int i = 0; i < 8; i++) {
+            uint64_t row = (opened >> (8 * i)) & 0xFF;
+            if (!row) continue;
+            words[i] |= TileSpread(row) << 5;
+            memcpy(base + (size_t)i * width, &words[i], validCols);
+            int rowBase = (r0 + i) * width + c0;
+            while (row) {
+                revealed.push_back(rowBase + (int)bitboardLowestBit(row));
+                row &= row - 1;
+            }
+        }
+        if (!expanded) continue;
+
+        // 边缘上展开过的 0 雷格，把相邻块里挨着它的格子作为候选
+        auto push = [&](int dr, int dc, uint64_t cand) {
+            int tr = item.tileRow + dr, tc = item.tileCol + dc;
+            if (!cand || tr < 0 || tr >= tileRows || tc < 0 || tc >= tileCols) return;
+            TileWork next = {tr, tc, cand};
+            work.push_back(next);
+        };
+        uint64_t top = expanded & 0xFF, bottom = expanded >> 56;
+        uint64_t left = expanded & TILE_COL0, right = expanded & TILE_COL7;
+        if (top) {
+            uint64_t h = top | ((top << 1) & 0xFE) | ((top >> 1) & 0x7F);
+            push(-1, 0, h << 56);
+            if (top & 0x01) push(-1, -1, 1ull << 63);
+            if (top & 0x80) push(-1, 1, 1ull << 56);
+        }
+        if (bottom) {
+            uint64_t h = bottom | ((bottom << 1) & 0xFE) | ((bottom >> 1) & 0x7F);
+            push(1, 0, h);
+            if (bottom & 0x01) push(1, -1, 1ull << 7);
+            if (bottom & 0x80) push(1, 1, 1ull);
+        }
+        if (left) push(0, -1, ((left | (left << 8) | (left >> 8)) << 7) & TILE_COL7);
+        if (right) push(0, 1, ((right | (right << 8) | (right >> 8)) >> 7) & TILE_COL0);
+    }
+    return (int)(revealed.size() - before);
+}
+
+// ================= 多线程逐层展开 =================
+
+static inline uint8_t LoadCell(const uint8_t* cell) {
+#if defined(_MSC_VER)
+    return *(const volatile uint8_t*)cell;
+#else
+    return __atomic_load_n(cell, __ATOMIC_RELAXED);
+#endif
+}
+
+// 给格子打上已翻开标记，返回之前的值；多个线程抢同一格时只有一个看到未翻开
+static inline uint8_t ClaimCell(uint8_t* cell) {
+#if defined(_MSC_VER)
+    return (uint8_t)_InterlockedOr8((volatile char*)cell, (char)CELL_REVEALED);
+#else
+    return __atomic_fetch_or(cell, (uint8_t)CELL_REVEALED, __ATOMIC_RELAXED);
+#endif
+}
+
+int revealParallel(uint8_t* cells, int stride, int start, std::vector<int>& revealed) {
+    if (cells[start] & (CELL_REVEALED | CELL_MINE)) return 0;
+
+    int offsets[8];
+    for (int k = 0; k < 8; k++) offsets[k] = neighbourOffset(k, stride);
+
+    size_t head = revealed.size();
+    const size_t first = head;
+    cells[start] |= CELL_REVEALED;
+    revealed.push_back(start);
+
+    // 每块新抢到的格子先放进自己的列表，一层结束后依次接到 revealed 末尾，成为下一层
+    // 工作线程里的 thread_local 是各自的一份，所以 lambda 里要通过引用访问调用线程的这份
+    static thread_local std::vector<std::vector<int> > partsStorage;
+    std::vector<std::vector<int> >& parts = partsStorage;
+    const int threads = parallelThreads();
+    while (head < revealed.size()) {
+        const size_t level = revealed.size() - head;
+        int blocks = (int)((level + REVEAL_PARALLEL_GRAIN - 1) / REVEAL_PARALLEL_GRAIN);
+        if (blocks > threads * 4) blocks = threads * 4;
+        if ((int)parts.size() < blocks) parts.resize(blocks);
+
+        const int* frontier = revealed.data() + head;
+        parallelFor(0, blocks, 1, [&](int from, int to) {
+            for (int b = from; b < to; b++) {
+                std::vector<int>& out = parts[b];
+                out.clear();
+                const size_t lo = level * b / blocks, hi = level * (b + 1) / blocks;
+                for (size_t i = lo; i < hi; i++) {
+                    int idx = frontier[i];
+                    if (cellCount(LoadCell(&cells[idx])) != 0) continue;
+                    for (int k = 0; k < 8; k++) {
+                        int n = idx + offsets[k];
+                        // 先普通地读一次，已翻开的格子不必再做原子操作
+                        if (LoadCell(&cells[n]) & (CELL_REVEALED | CELL_MINE)) continue;
+                        if (ClaimCell(&cells[n]) & CELL_REVEALED) continue;
+                        out.push_back(n);
+                    }
+                }
+            }
+        });
+
+        head = revealed.size();
+        for (int b = 0; b < blocks; b++) revealed.insert(revealed.end(), parts[b].begin(), parts[b].end());
+    }
+    return (int)(revealed.size() - first);
+}
+
+int revealFrom(uint8_t* cells, int rows, int cols, int start, std::vector<int>& revealed) {
+    if (boardCellCount(rows, cols) >= REVEAL_TILE_MIN_CELLS) {
+        return revealTiles(cells, rows, cols, start, revealed);
+    }
+    return revealFlood(cells, boardStride(cols), start, revealed);
+}
@@ -0,0 +1,110 @@
+#include "rng.h"
+#include <ctime>
+#include <chrono>
+#include <atomic>
+#include <random>
+
+// Philox4x32-10 常量 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+static const uint32_t PHILOX_M0 = 0xD2511F53u;
+static const uint32_t PHILOX_M1 = 0xCD9E8D57u;
+static const uint32_t PHILOX_W0 = 0x9E3779B9u;
+static const uint32_t PHILOX_W1 = 0xBB67AE85u;
+
+static uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// 对 counter 做 10 轮 Philox，结果写入 out
+static void philoxBlock(const uint32_t key[2], const uint32_t counter[4], uint32_t out[4]) {
+    uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < 10; round++) {
+        uint64_t p0 = (uint64_t)PHILOX_M0 * c0;
+        uint64_t p1 = (uint64_t)PHILOX_M1 * c2;
+        uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c1 = (uint32_t)p1;
+        c3 = (uint32_t)p0;
+        c0 = n0;
+        c2 = n2;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+}
+
+void rngInit(BoardRng& rng, uint64_t seed, int rows, int cols, int mineCount, uint32_t stream) {
+    uint64_t k = splitmix64(seed);
+    k = splitmix64(k ^ (uint32_t)rows);
+    k = splitmix64(k ^ ((uint64_t)(uint32_t)cols << 32));
+    k = splitmix64(k ^ (uint32_t)mineCount);
+    rng.key[0] = (uint32_t)k;
+    rng.key[1] = (uint32_t)(k >> 32);
+    rng.counter[0] = 0;
+    rng.counter[1] = 0;
+    rng.counter[2] = stream;
+    rng.counter[3] = 0;
+    rng.used = 4;
+}
+
+uint32_t rngNext(BoardRng& rng) {
+    if (rng.used == 4) {
+        philoxBlock(rng.key, rng.counter, rng.block);
+        // 64 位块计数器，够用一辈子
+        if (++rng.counter[0] == 0) rng.counter[1]++;
+        rng.used = 0;
+    }
+    return rng.block[rng.used++];
+}
+
+uint32_t rngBelow(BoardRng& rng, uint32_t bound) {
+    // Lemire 乘法取区间 + 拒绝采样，去掉取模带来的偏差
+    uint64_t m = (uint64_t)rngNext(rng) * bound;
+    uint32_t low = (uint32_t)m;
+    if (low < bound) {
+        uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            m = (uint64_t)rngNext(rng) * bound;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+uint64_t rngBelow64(BoardRng& rng, uint64_t bound) {
+    if (bound <= 0xFFFFFFFFull) return rngBelow(rng, (uint32_t)bound);
+    // 两个 32 位拼成 64 位；只接受 bound 整数倍以内的值，取模后没有偏差
+    uint64_t limit = UINT64_MAX - UINT64_MAX % bound;
+    while (true) {
+        uint64_t x = (uint64_t)rngNext(rng) << 32;
+        x |= rngNext(rng);
+        if (x < limit) return x % bound;
+    }
+}
+
+int rngRange(BoardRng& rng, int low, int high) {
+    return low + (int)rngBelow(rng, (uint32_t)(high - low) + 1u);
+}
+
+uint64_t rngHash(uint64_t seed, int64_t a, int64_t b) {
+    uint64_t k = splitmix64(seed);
+    k = splitmix64(k ^ (uint64_t)a);
+    return splitmix64(k ^ ((uint64_t)b * 0x9E3779B97F4A7C15ull));
+}
+
+uint64_t rngFreshSeed() {
+    static std::atomic<uint64_t> calls(0);
+    uint64_t entropy = (uint64_t)time(nullptr);
+    entropy ^= (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count() << 1;
+    entropy ^= calls.fetch_add(1) * 0xD1B54A32D192ED03ull;
+    try {
+        std::random_device device;
+        entropy ^= ((uint64_t)device() << 32) | device();
+    } catch (...) {
+        // 某些平台没有 random_device，只用时间熵即可
+    }
+    return splitmix64(entropy) % 0x7FFFFFFFull + 1;
+}
@@ -0,0 +1,261 @@
+#include "sparse_board.h"
+#include "game.h"
+#include "rng.h"
+#include <algorithm>
+
+using namespace std;
+
+// ================= 后端选择 =================
+
+bool boardPrefersSparse(int64_t rows, int64_t cols, int64_t mineCount) {
+    const int64_t cells = rows * cols;
+    if (cells > DENSE_MAX_CELLS) return true;
+    if (cells < SPARSE_MIN_CELLS) return false;
+    // 稀疏存储约每颗雷 4 字节 + 每行 8 字节，稠密每格 1 字节
+    return mineCount * 4 + rows * 8 < cells / 16;
+}
+
+int64_t boardMaxMines(int64_t rows, int64_t cols) {
+    const int64_t cells = rows * cols;
+    return cells > DENSE_MAX_CELLS ? SPARSE_MAX_MINES : cells;
+}
+
+// ================= 布雷 =================
+
+void sparseGenerate(SparseBoard& board, int rows, int cols, int mineCount, uint64_t seed) {
+    sparseRelease(board);
+    board.rows = rows;
+    board.cols = cols;
+    board.mineCount = mineCount;
+    board.pageCols = ((int64_t)cols + SPARSE_PAGE_SIZE - 1) >> SPARSE_PAGE_SHIFT;
+    const uint64_t total = (uint64_t)rows * cols;
+
+    // 先独立均匀地抽 mineCount 个下标。Philox 可以重放，第一遍只数每行几个，
+    // 第二遍按行首下标把列号直接填进 CSR，不需要再存一份 64 位下标
+    board.rowStart.assign((size_t)rows + 1, 0);
+    BoardRng rng;
+    rngInit(rng, seed, rows, cols, mineCount);
+    for (int k = 0; k < mineCount; k++) board.rowStart[rngBelow64(rng, total) / cols + 1]++;
+    for (int r = 0; r < rows; r++) board.rowStart[r + 1] += board.rowStart[r];
+
+    board.mineCols.resize(mineCount);
+    {
+        vector<int64_t> fill(board.rowStart.begin(), board.rowStart.end() - 1);
+        rngInit(rng, seed, rows, cols, mineCount);
+        for (int k = 0; k < mineCount; k++) {
+            uint64_t pick = rngBelow64(rng, total);
+            board.mineCols[fill[pick / cols]++] = (uint32_t)(pick % cols);
+        }
+    }
+
+    // 各行排序去重，重复的下标留到最后补抽
+    int64_t kept = 0;
+    for (int r = 0; r < rows; r++) {
+        uint32_t* first = board.mineCols.data() + board.rowStart[r];
+        uint32_t* last = board.mineCols.data() + board.rowStart[r + 1];
+        sort(first, last);
+        last = unique(first, last);
+        board.rowStart[r] = kept;
+        for (uint32_t* it = first; it != last; it++) board.mineCols[kept++] = *it;
+    }
+    board.rowStart[rows] = kept;
+
+    // 补抽：接着同一条随机流，在还不是雷的格子里均匀地抽，凑满后从后往前归并进 CSR。
+    // 每一步都与格子的编号无关，所以最终是均匀的 mineCount 元子集；低密度下只需补几千个
+    vector<uint64_t> extra;
+    while ((int64_t)extra.size() < mineCount - kept) {
+        while ((int64_t)extra.size() < mineCount - kept) {
+            uint64_t pick = rngBelow64(rng, total);
+            if (!sparseIsMine(board, (int64_t)(pick / cols), (int64_t)(pick % cols))) extra.push_back(pick);
+        }
+        sort(extra.begin(), extra.end());
+        extra.erase(unique(extra.begin(), extra.end()), extra.end());
+    }
+    if (extra.empty()) return;
+
+    board.mineCols.resize(mineCount);
+    int64_t write = mineCount;
+    size_t e = extra.size();
+    for (int r = rows - 1; r >= 0; r--) {
+        int64_t read = board.rowStart[r + 1];
+        board.rowStart[r + 1] = write;
+        while (e > 0 && (int64_t)(extra[e - 1] / cols) == r) {
+            uint32_t col = (uint32_t)(extra[e - 1] % cols);
+            while (read > board.rowStart[r] && board.mineCols[read - 1] > col) board.mineCols[--write] = board.mineCols[--read];
+            board.mineCols[--write] = col;
+            e--;
+        }
+        while (read > board.rowStart[r]) board.mineCols[--write] = board.mineCols[--read];
+        if (e == 0) break;
+    }
+}
+
+void sparseRelease(SparseBoard& board) {
+    vector<int64_t>().swap(board.rowStart);
+    vector<uint32_t>().swap(board.mineCols);
+    board.pages.clear();
+    board.rows = 0;
+    board.cols = 0;
+    board.mineCount = 0;
+    board.pageCols = 0;
+    board.revealedCount = 0;
+}
+
+static void InsertMine(SparseBoard& board, int64_t r, int64_t c) {
+    auto first = board.mineCols.begin() + board.rowStart[r];
+    auto last = board.mineCols.begin() + board.rowStart[r + 1];
+    board.mineCols.insert(lower_bound(first, last, (uint32_t)c), (uint32_t)c);
+    for (int64_t i = r + 1; i <= board.rows; i++) board.rowStart[i]++;
+}
+
+static void EraseMine(SparseBoard& board, int64_t r, int64_t c) {
+    auto first = board.mineCols.begin() + board.rowStart[r];
+    auto last = board.mineCols.begin() + board.rowStart[r + 1];
+    board.mineCols.erase(lower_bound(first, last, (uint32_t)c));
+    for (int64_t i = r + 1; i <= board.rows; i++) board.rowStart[i]--;
+}
+
+bool sparseRelocate(SparseBoard& board, int64_t r, int64_t c, bool SafeZone, uint64_t seed) {
+    int radius = safeZoneRadius((int)r, (int)c, (int)board.rows, (int)board.cols, (int)board.mineCount, SafeZone);
+    if (radius < 0) return false;
+
+    const int64_t r0 = max(r - radius, (int64_t)0), r1 = min(r + radius, board.rows - 1);
+    const int64_t c0 = max(c - radius, (int64_t)0), c1 = min(c + radius, board.cols - 1);
+
+    int movedCount = 0;
+    for (int64_t i = r0; i <= r1; i++) {
+        for (int64_t j = c0; j <= c1; j++) {
+            if (!sparseIsMine(board, i, j)) continue;
+            EraseMine(board, i, j);
+            movedCount++;
+        }
+    }
+    if (movedCount == 0) return false;
+
+    // 与布雷用的随机流相互独立；稀疏棋盘上拒绝采样几乎一次就中
+    BoardRng rng;
+    rngInit(rng, seed, (int)board.rows, (int)board.cols, (int)board.mineCount, 1);
+    const uint64_t total = (uint64_t)board.rows * board.cols;
+    while (movedCount > 0) {
+        uint64_t target = rngBelow64(rng, total);
+        int64_t i = (int64_t)(target / board.cols);
+        int64_t j = (int64_t)(target % board.cols);
+        if (i >= r0 && i <= r1 && j >= c0 && j <= c1) continue;
+        if (sparseIsMine(board, i, j)) continue;
+        InsertMine(board, i, j);
+        movedCount--;
+    }
+    return true;
+}
+
+// ================= 查询 =================
+
+// 第 r 行在 [c0, c1] 内的雷数
+static int RowMines(const SparseBoard& board, int64_t r, int64_t c0, int64_t c1) {
+    const uint32_t* first = board.mineCols.data() + board.rowStart[r];
+    const uint32_t* last = board.mineCols.data() + board.rowStart[r + 1];
+    const uint32_t* it = lower_bound(first, last, (uint32_t)c0);
+    int n = 0;
+    while (it != last && *it <= (uint32_t)c1) {
+        n++;
+        it++;
+    }
+    return n;
+}
+
+bool sparseIsMine(const SparseBoard& board, int64_t r, int64_t c) {
+    return RowMines(board, r, c, c) != 0;
+}
+
+int sparseCount(const SparseBoard& board, int64_t r, int64_t c) {
+    const int64_t c0 = max(c - 1, (int64_t)0), c1 = min(c + 1, board.cols - 1);
+    int n = 0;
+    for (int64_t i = max(r - 1, (int64_t)0); i <= min(r + 1, board.rows - 1); i++) {
+        n += RowMines(board, i, c0, c1);
+    }
+    return n - (int)sparseIsMine(board, r, c);
+}
+
+static inline int64_t PageKey(const SparseBoard& board, int64_t r, int64_t c) {
+    return (r >> SPARSE_PAGE_SHIFT) * board.pageCols + (c >> SPARSE_PAGE_SHIFT);
+}
+
+uint8_t sparseCell(const SparseBoard& board, int64_t r, int64_t c) {
+    uint8_t cell = sparseIsMine(board, r, c) ? CELL_MINE : (uint8_t)sparseCount(board, r, c);
+    auto page = board.pages.find(PageKey(board, r, c));
+    if (page != board.pages.end()) {
+        const int pr = (int)(r & (SPARSE_PAGE_SIZE - 1)), pc = (int)(c & (SPARSE_PAGE_SIZE - 1));
+        if ((page->second.revealed[pr] >> pc) & 1) cell |= CELL_REVEALED;
+        if ((page->second.flagged[pr] >> pc) & 1) cell |= CELL_FLAG;
+    }
+    return cell;
+}
+
+// ================= 翻开与插旗 =================
+
+// 取 (r, c) 所在的页，没有时分配一页全 0 的
+static SparsePage& PageAt(SparseBoard& board, int64_t r, int64_t c) {
+    return board.pages[PageKey(board, r, c)];
+}
+
+int sparseReveal(SparseBoard& board, int64_t r, int64_t c, vector<WorldPos>& revealed) {
+    const uint64_t bit0 = 1;
+    const int mask = SPARSE_PAGE_SIZE - 1;
+
+    uint8_t start = sparseCell(board, r, c);
+    if (start & (CELL_REVEALED | CELL_MINE)) return 0;
+
+    size_t head = revealed.size();
+    const size_t first = head;
+    PageAt(board, r, c).revealed[r & mask] |= bit0 << (c & mask);
+    WorldPos origin = {c, r};
+    revealed.push_back(origin);
+
+    while (head < revealed.size() && revealed.size() - first < SPARSE_FLOOD_LIMIT) {
+        WorldPos p = revealed[head++];
+        if (sparseCount(board, p.y, p.x) != 0) continue;
+        for (int k = 0; k < 8; k++) {
+            int64_t ny = p.y + NEIGHBOURS[k].dr;
+            int64_t nx = p.x + NEIGHBOURS[k].dc;
+            if (ny < 0 || ny >= board.rows || nx < 0 || nx >= board.cols) continue;
+            SparsePage& page = PageAt(board, ny, nx);
+            uint64_t bit = bit0 << (nx & mask);
+            if (page.revealed[ny & mask] & bit) continue;
+            // 0 雷格子的邻格不会是雷
+            page.revealed[ny & mask] |= bit;
+            WorldPos n = {nx, ny};
+            revealed.push_back(n);
+        }
+    }
+
+    // 到达上限时，还没展开的空白格退回未翻开状态，玩家点它即可接着展开
+    size_t kept = head;
+    for (size_t i = head; i < revealed.size(); i++) {
+        WorldPos p = revealed[i];
+        if (sparseCount(board, p.y, p.x) == 0) {
+            PageAt(board, p.y, p.x).revealed[p.y & mask] &= ~(bit0 << (p.x & mask));
+        } else {
+            revealed[kept++] = p;
+        }
+    }
+    revealed.resize(kept);
+
+    int added = (int)(revealed.size() - first);
+    board.revealedCount += added;
+    return added;
+}
+
+bool sparseToggleFlag(SparseBoard& board, int64_t r, int64_t c) {
+    const int mask = SPARSE_PAGE_SIZE - 1;
+    SparsePage& page = PageAt(board, r, c);
+    uint64_t bit = (uint64_t)1 << (c & mask);
+    if (page.revealed[r & mask] & bit) return false;
+    page.flagged[r & mask] ^= bit;
+    return (page.flagged[r & mask] & bit) != 0;
+}
+
+size_t sparseBytes(const SparseBoard& board) {
+    // 哈希表每个节点另有指针与桶的开销，按 32 字节估算
+    return board.rowStart.capacity() * sizeof(int64_t) + board.mineCols.capacity() * sizeof(uint32_t) +
+           board.pages.size() * (sizeof(SparsePage) + 32);
+}
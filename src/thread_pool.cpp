@@ -0,0 +1,130 @@
+#include "thread_pool.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// 每个参与者的块数，块多一些可以让先做完的线程多分担
+#define BLOCKS_PER_THREAD 4
+
+static mutex jobMutex;              // 同一时刻只跑一个并行任务，其余调用者退回串行
+static mutex stateMutex;
+static condition_variable wakeCond;
+static condition_variable doneCond;
+static vector<thread> workers;
+static int wantedThreads = 0;
+static bool stopWorkers = false;
+
+// 当前任务
+static ParallelBody jobBody = NULL;
+static const void* jobContext = NULL;
+static int jobBegin = 0;
+static int jobEnd = 0;
+static int jobBlock = 1;
+static atomic<int> nextBlock(0);
+static int blockCount = 0;
+static unsigned jobSerial = 0;
+static int workersDone = 0;      // 已做完当前任务的工作线程数
+
+// hardware_concurrency 每次都要读系统信息（Linux 上是一次文件读取），只查一次
+static int HardwareThreads() {
+    static const int count = [] {
+        unsigned n = thread::hardware_concurrency();
+        return n == 0 ? 1 : (int)n;
+    }();
+    return count;
+}
+
+// 领取并执行剩余的块，直到做完
+static void RunBlocks() {
+    while (true) {
+        int b = nextBlock++;
+        if (b >= blockCount) return;
+        int from = jobBegin + b * jobBlock;
+        int to = from + jobBlock < jobEnd ? from + jobBlock : jobEnd;
+        jobBody(jobContext, from, to);
+    }
+}
+
+static void WorkerMain() {
+    unsigned seen = 0;
+    unique_lock<mutex> lock(stateMutex);
+    while (true) {
+        wakeCond.wait(lock, [&] { return stopWorkers || jobSerial != seen; });
+        if (stopWorkers) return;
+        seen = jobSerial;
+        lock.unlock();
+        RunBlocks();
+        lock.lock();
+        if (++workersDone == (int)workers.size()) doneCond.notify_all();
+    }
+}
+
+// 需持有 stateMutex
+static void StopWorkers(unique_lock<mutex>& lock) {
+    stopWorkers = true;
+    wakeCond.notify_all();
+    lock.unlock();
+    for (size_t i = 0; i < workers.size(); i++) workers[i].join();
+    lock.lock();
+    workers.clear();
+    stopWorkers = false;
+}
+
+int parallelThreads() {
+    lock_guard<mutex> lock(stateMutex);
+    return wantedThreads > 0 ? wantedThreads : HardwareThreads();
+}
+
+void parallelSetThreads(int n) {
+    lock_guard<mutex> job(jobMutex);
+    unique_lock<mutex> lock(stateMutex);
+    StopWorkers(lock);
+    wantedThreads = n > 0 ? n : 0;
+}
+
+void parallelForRaw(int begin, int end, int grain, ParallelBody body, const void* context) {
+    if (end <= begin) return;
+    if (grain < 1) grain = 1;
+
+    int threads = parallelThreads();
+    unique_lock<mutex> job(jobMutex, try_to_lock);
+    if (threads <= 1 || end - begin < 2 * grain || !job.owns_lock()) {
+        body(context, begin, end);
+        return;
+    }
+
+    unique_lock<mutex> lock(stateMutex);
+    while ((int)workers.size() < threads - 1) workers.push_back(thread(WorkerMain));
+
+    int block = (end - begin + threads * BLOCKS_PER_THREAD - 1) / (threads * BLOCKS_PER_THREAD);
+    jobBody = body;
+    jobContext = context;
+    jobBegin = begin;
+    jobEnd = end;
+    jobBlock = block < grain ? grain : block;
+    blockCount = (end - begin + jobBlock - 1) / jobBlock;
+    nextBlock = 0;
+    workersDone = 0;
+    jobSerial++;
+    wakeCond.notify_all();
+    lock.unlock();
+
+    RunBlocks();
+
+    // 每个工作线程对每个任务都恰好响应一次，全部响应完才算结束，
+    // 这样下一个任务改写参数时不会有线程还在读上一个任务
+    lock.lock();
+    doneCond.wait(lock, [] { return workersDone == (int)workers.size(); });
+    jobBody = NULL;
+    jobContext = NULL;
+}
+
+void parallelShutdown() {
+    lock_guard<mutex> job(jobMutex);
+    unique_lock<mutex> lock(stateMutex);
+    StopWorkers(lock);
+}
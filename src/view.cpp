@@ -0,0 +1,558 @@
+#include "view.h"
+#include "cgt.h"
+#include "game.h"
+#include "count_tree.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+using namespace std;
+
+// 每按一次方向键视口移动的格子数
+#define VIEW_STEP 4
+// 小地图在视口右侧，每个字符覆盖 2^scale 列、2^(scale + 1) 行（字符的高大约是宽的两倍）
+#define MINIMAP_COLS 32
+#define MINIMAP_ROWS 16
+#define MINIMAP_Y 4
+
+// 棋盘左上角的屏幕坐标
+#define VIEW_X 3
+#define VIEW_Y 3
+
+int64_t viewCameraX = 0;
+int64_t viewCameraY = 0;
+int viewRows = VIEW_ROWS;
+int viewCols = VIEW_COLS;
+bool viewCompact = false;
+
+// 一种格子画法：每格在屏幕上占 pitchX x pitchY 个字符，其中左边、上边 gutter 个字符是格线
+struct ViewLayout {
+    int pitchX;
+    int pitchY;
+    int gutter;
+    int rows;           // 视口最多显示的行数、列数
+    int cols;
+};
+
+// 普通画法：3 行 x 4 列，带格线；紧凑画法：1 行 x 2 列，没有格线
+static const ViewLayout LAYOUT_NORMAL = {4, 3, 1, VIEW_ROWS, VIEW_COLS};
+static const ViewLayout LAYOUT_COMPACT = {2, 1, 0, VIEW_COMPACT_ROWS, VIEW_COMPACT_COLS};
+static const ViewLayout* layout = &LAYOUT_NORMAL;
+
+// 格子的每种样子，下标见 SPRITE_*；每局按画法建一次，画格子只查表
+struct CellSprite {
+    char text[3];       // 紧凑画法整格的两个字符
+    char glyph;         // 普通画法色块正中的字符
+    int fg;
+    int bg;
+};
+
+enum {
+    SPRITE_OUTSIDE,     // 棋盘以外，与格线同色
+    SPRITE_HIDDEN,
+    SPRITE_HIDDEN_HOT,  // 鼠标悬停
+    SPRITE_FLAG,
+    SPRITE_FLAG_HOT,
+    SPRITE_EXPLODED,
+    SPRITE_NUMBER,      // 已翻开，后面依次是周围有 1 ~ 8 颗雷
+    SPRITE_COUNT = SPRITE_NUMBER + 9
+};
+
+// 已翻开格子上的数字颜色，0 不显示数字
+static const int NUMBER_COLORS[9] = {
+    COLOR_LIGHT_WHITE, COLOR_LIGHT_BLUE, COLOR_LIGHT_GREEN, COLOR_LIGHT_MAGENTA, COLOR_MAGENTA,
+    COLOR_BLUE, COLOR_LIGHT_RED, COLOR_LIGHT_RED, COLOR_RED,
+};
+
+static CellSprite sprites[SPRITE_COUNT];
+
+static const ViewBoard* view = NULL;
+static vector<WorldPos> viewRevealed;
+static vector<WorldPos> viewUnflagged;  // 翻开时收回了旗的格子
+static CountTree minimapTree;   // 有边界的棋盘上已翻开 / 插旗的格子数
+static int minimapScale = -1;   // -1 表示不显示小地图（无尽模式，或整块棋盘都在视口里）
+static int hoverR = -1;         // 鼠标悬停的视口格子，-1 表示没有
+static int hoverC = -1;
+static bool dragging = false;   // 中键按下到松开之间
+static int dragX = 0;           // 中键拖动时上一次换算过的鼠标位置
+static int dragY = 0;
+// 标题栏：只在操作之后或换了一秒时重新生成，与上次显示的一样就不输出
+static char hudText[192];
+static time_t hudSecond = 0;
+static bool hudDirty = true;
+
+static bool InBoard(int64_t x, int64_t y) {
+    if (view->cols > 0 && (x < 0 || x >= view->cols)) return false;
+    if (view->rows > 0 && (y < 0 || y >= view->rows)) return false;
+    return true;
+}
+
+static inline int MinimapX() {
+    return VIEW_X + viewCols * layout->pitchX + 3;
+}
+
+// ================= 格子绘制 =================
+
+// 视口第 r 行第 c 列格子（不含格线）左上角的屏幕坐标
+static inline int CellScreenX(int c) {
+    return VIEW_X + c * layout->pitchX + layout->gutter;
+}
+
+static inline int CellScreenY(int r) {
+    return VIEW_Y + r * layout->pitchY + layout->gutter;
+}
+
+static void SetSprite(int index, char glyph, int fg, int bg) {
+    CellSprite& s = sprites[index];
+    s.text[0] = glyph;
+    s.text[1] = ' ';
+    s.text[2] = '\0';
+    s.glyph = glyph;
+    s.fg = fg;
+    s.bg = bg;
+}
+
+// 按当前画法建好所有格子样子
+static void BuildSprites() {
+    SetSprite(SPRITE_OUTSIDE, ' ', COLOR_WHITE, COLOR_WHITE);
+    // 紧凑画法没有格线，未翻开的格子画一个点以便数清
+    const char hidden = layout->gutter == 0 ? '.' : ' ';
+    SetSprite(SPRITE_HIDDEN, hidden, COLOR_BLACK, COLOR_YELLOW);
+    SetSprite(SPRITE_HIDDEN_HOT, hidden, COLOR_BLACK, COLOR_LIGHT_YELLOW);
+    SetSprite(SPRITE_FLAG, 'F', COLOR_BLACK, COLOR_RED);
+    SetSprite(SPRITE_FLAG_HOT, 'F', COLOR_BLACK, COLOR_LIGHT_RED);
+    SetSprite(SPRITE_EXPLODED, '*', COLOR_BLACK, COLOR_MAGENTA);
+    for (int n = 0; n <= 8; n++) {
+        SetSprite(SPRITE_NUMBER + n, n > 0 ? (char)('0' + n) : ' ', NUMBER_COLORS[n], COLOR_LIGHT_WHITE);
+    }
+}
+
+// 普通画法：先填 3x2 色块，字符在下排正中；紧凑画法：两个字符一次输出
+static void PaintSprite(int r, int c, int index) {
+    const CellSprite& s = sprites[index];
+    int x = CellScreenX(c);
+    int y = CellScreenY(r);
+    if (layout->gutter == 0) {
+        cgt_print_str(s.text, x, y, s.fg, s.bg);
+        return;
+    }
+    cgt_fill_rect(x, y, layout->pitchX - layout->gutter, layout->pitchY - layout->gutter, s.bg, s.bg);
+    if (s.glyph != ' ') cgt_print_char(s.glyph, x + 1, y + 1, s.fg, s.bg);
+}
+
+// 视口第 r 行第 c 列的格子；棋盘以外画成与格线相同的底色，鼠标悬停的未翻开格子画成亮色
+static void PaintViewCell(int r, int c) {
+    if (!InBoard(viewCameraX + c, viewCameraY + r)) {
+        PaintSprite(r, c, SPRITE_OUTSIDE);
+        return;
+    }
+    const bool hot = r == hoverR && c == hoverC;
+    uint8_t cell = view->peek(viewCameraX + c, viewCameraY + r);
+    // 插错的旗会被展开翻开，翻开的格子一律按翻开画
+    if (cellIsRevealed(cell)) {
+        PaintSprite(r, c, SPRITE_NUMBER + cellCount(cell));
+    } else if (cellIsFlagged(cell)) {
+        PaintSprite(r, c, hot ? SPRITE_FLAG_HOT : SPRITE_FLAG);
+    } else {
+        PaintSprite(r, c, hot ? SPRITE_HIDDEN_HOT : SPRITE_HIDDEN);
+    }
+}
+
+// 鼠标移到视口第 r 行第 c 列（-1 表示移出棋盘），只重画高亮变化的两格
+static void UpdateHover(int r, int c) {
+    if (r == hoverR && c == hoverC) return;
+    int oldR = hoverR, oldC = hoverC;
+    hoverR = r;
+    hoverC = c;
+    if (oldR >= 0) PaintViewCell(oldR, oldC);
+    if (r >= 0) PaintViewCell(r, c);
+}
+
+// ================= 小地图 =================
+
+// 第 scale 层第 ny 行第 nx 列的方块里的格子数、已翻开数、插旗数。
+// 方块不小于计数树的叶子时查一次树，更小时逐格查（至多 2^(2 * COUNT_TREE_LEAF_SHIFT) 格）
+static void MinimapBlock(int64_t nx, int64_t ny, int scale, int64_t& area, int64_t& revealed, int64_t& flagged) {
+    const int64_t x0 = nx << scale, y0 = ny << scale;
+    const int64_t x1 = min(x0 + ((int64_t)1 << scale), view->cols), y1 = min(y0 + ((int64_t)1 << scale), view->rows);
+    if (x0 >= x1 || y0 >= y1) return;
+    area += (x1 - x0) * (y1 - y0);
+    if (scale >= COUNT_TREE_LEAF_SHIFT) {
+        CountNode node = countTreeNode(minimapTree, scale, nx, ny);
+        revealed += node.revealed;
+        flagged += node.flagged;
+        return;
+    }
+    for (int64_t y = y0; y < y1; y++) {
+        for (int64_t x = x0; x < x1; x++) {
+            uint8_t cell = view->peek(x, y);
+            revealed += cellIsRevealed(cell);
+            flagged += cellIsFlagged(cell);
+        }
+    }
+}
+
+// 小地图第 cy 行第 cx 列的字符：上下两个方块合起来着色，与视口重叠的字符画 '#'
+static void PaintMinimapCell(int cx, int cy) {
+    int64_t area = 0, revealed = 0, flagged = 0;
+    MinimapBlock(cx, 2 * cy, minimapScale, area, revealed, flagged);
+    MinimapBlock(cx, 2 * cy + 1, minimapScale, area, revealed, flagged);
+
+    int color;
+    if (area == 0) color = COLOR_BLACK;
+    else if (revealed == area) color = COLOR_LIGHT_WHITE;
+    else if (flagged > 0) color = COLOR_RED;
+    else if (revealed > 0) color = COLOR_WHITE;
+    else color = COLOR_YELLOW;
+
+    const int64_t x0 = (int64_t)cx << minimapScale, y0 = (int64_t)cy << (minimapScale + 1);
+    bool inView = x0 < viewCameraX + viewCols && x0 + ((int64_t)1 << minimapScale) > viewCameraX &&
+                  y0 < viewCameraY + viewRows && y0 + ((int64_t)2 << minimapScale) > viewCameraY;
+    cgt_print_char(inView ? '#' : ' ', MinimapX() + cx, MINIMAP_Y + cy, COLOR_BLACK, color);
+}
+
+// 棋盘有边界、又放不进视口时才有小地图；取能把整块棋盘放进 MINIMAP_COLS x MINIMAP_ROWS 的最小尺度
+static void MinimapSetup() {
+    minimapScale = -1;
+    if (view->rows <= viewRows && view->cols <= viewCols) return;
+    if (view->rows <= 0 || view->cols <= 0) return;
+    countTreeInit(minimapTree, view->rows, view->cols);
+    int scale = 0;
+    while (((view->cols + ((int64_t)1 << scale) - 1) >> scale) > MINIMAP_COLS ||
+           ((view->rows + ((int64_t)2 << scale) - 1) >> (scale + 1)) > MINIMAP_ROWS) {
+        scale++;
+    }
+    minimapScale = scale;
+}
+
+static void DrawMinimap() {
+    if (minimapScale < 0) return;
+    char buf[64];
+    snprintf(buf, sizeof(buf), "小地图 : 每格 %lld x %lld", 1LL << minimapScale, 2LL << minimapScale);
+    cgt_print_str(buf, MinimapX(), MINIMAP_Y - 1, COLOR_WHITE, COLOR_BLACK);
+    for (int cy = 0; cy < MINIMAP_ROWS; cy++) {
+        for (int cx = 0; cx < MINIMAP_COLS; cx++) PaintMinimapCell(cx, cy);
+    }
+}
+
+// 把新翻开的格子记入计数树，只重画它们落到的小地图字符
+static void UpdateMinimap() {
+    if (minimapScale < 0 || viewRevealed.empty()) return;
+    countTreeAddRevealed(minimapTree, viewRevealed.data(), viewRevealed.size());
+    bool dirty[MINIMAP_ROWS][MINIMAP_COLS] = {};
+    for (size_t i = 0; i < viewRevealed.size(); i++) {
+        dirty[viewRevealed[i].y >> (minimapScale + 1)][viewRevealed[i].x >> minimapScale] = true;
+    }
+    for (int cy = 0; cy < MINIMAP_ROWS; cy++) {
+        for (int cx = 0; cx < MINIMAP_COLS; cx++) {
+            if (dirty[cy][cx]) PaintMinimapCell(cx, cy);
+        }
+    }
+}
+
+static void UpdateMinimapFlag(int64_t x, int64_t y, int delta) {
+    if (minimapScale < 0) return;
+    countTreeAddFlag(minimapTree, x, y, delta);
+    PaintMinimapCell((int)(x >> minimapScale), (int)(y >> (minimapScale + 1)));
+}
+
+// ================= 视口绘制与移动 =================
+
+static void DrawView() {
+    // 格线只有普通画法才有：整块填成格线色，再把格子画在上面
+    if (layout->gutter > 0) {
+        cgt_fill_rect(VIEW_X, VIEW_Y, viewCols * layout->pitchX + 1, viewRows * layout->pitchY + 1,
+                      COLOR_WHITE, COLOR_WHITE);
+    }
+    for (int r = 0; r < viewRows; r++) {
+        for (int c = 0; c < viewCols; c++) PaintViewCell(r, c);
+    }
+    DrawMinimap();
+}
+
+// 只重画本次新翻开、且落在视口里的格子，再更新小地图
+static void PaintViewRevealed() {
+    for (size_t i = 0; i < viewRevealed.size(); i++) {
+        int64_t r = viewRevealed[i].y - viewCameraY;
+        int64_t c = viewRevealed[i].x - viewCameraX;
+        if (r >= 0 && r < viewRows && c >= 0 && c < viewCols) PaintViewCell((int)r, (int)c);
+    }
+    UpdateMinimap();
+    for (size_t i = 0; i < viewUnflagged.size(); i++) UpdateMinimapFlag(viewUnflagged[i].x, viewUnflagged[i].y, -1);
+    viewRevealed.clear();
+    viewUnflagged.clear();
+}
+
+// 每轮循环都会调用：空闲时一秒只生成一次标题，鼠标移动不会引起重画
+static void DrawTitle() {
+    time_t now = time(NULL);
+    if (!hudDirty && now == hudSecond) return;
+    hudDirty = false;
+    hudSecond = now;
+    char buf[sizeof(hudText)];
+    view->formatTitle(buf, sizeof(buf));
+    if (strcmp(buf, hudText) == 0) return;
+    memcpy(hudText, buf, sizeof(buf));
+    cgt_print_str(buf, 1, 1, COLOR_WHITE, COLOR_BLACK);
+}
+
+// 屏幕坐标落在某个格子内（不含格线）时给出视口行列
+static bool ViewCellAt(int x, int y, int& r, int& c) {
+    int dx = x - VIEW_X;
+    int dy = y - VIEW_Y;
+    if (dx < 0 || dy < 0 || dx >= viewCols * layout->pitchX || dy >= viewRows * layout->pitchY) return false;
+    if (dx % layout->pitchX < layout->gutter || dy % layout->pitchY < layout->gutter) return false;
+    r = dy / layout->pitchY;
+    c = dx / layout->pitchX;
+    return true;
+}
+
+// 有边界的棋盘上，视口不移出棋盘
+static void ClampCamera() {
+    if (view->cols > 0) {
+        if (viewCameraX > view->cols - viewCols) viewCameraX = view->cols - viewCols;
+        if (viewCameraX < 0) viewCameraX = 0;
+    }
+    if (view->rows > 0) {
+        if (viewCameraY > view->rows - viewRows) viewCameraY = view->rows - viewRows;
+        if (viewCameraY < 0) viewCameraY = 0;
+    }
+}
+
+// 视口移到左上角 (x, y)，真的移动了才重画；整个视口在同一帧里换掉
+static void MoveCamera(int64_t x, int64_t y) {
+    int64_t oldX = viewCameraX, oldY = viewCameraY;
+    viewCameraX = x;
+    viewCameraY = y;
+    ClampCamera();
+    if (viewCameraX == oldX && viewCameraY == oldY) return;
+    hoverR = -1;
+    hoverC = -1;
+    hudDirty = true;
+    cgt_begin_frame();
+    if (view->settle) view->settle();
+    DrawView();
+    cgt_end_frame();
+}
+
+// 中键拖动：鼠标每移过一格，棋盘跟着移动一格
+static void DragCamera(int x, int y) {
+    int dc = (dragX - x) / layout->pitchX, dr = (dragY - y) / layout->pitchY;
+    if (dc == 0 && dr == 0) return;
+    dragX -= dc * layout->pitchX;
+    dragY -= dr * layout->pitchY;
+    MoveCamera(viewCameraX + dc, viewCameraY + dr);
+}
+
+// 点击小地图：视口中心移到被点的位置
+static bool MinimapJump(int x, int y) {
+    if (minimapScale < 0) return false;
+    int cx = x - MinimapX(), cy = y - MINIMAP_Y;
+    if (cx < 0 || cx >= MINIMAP_COLS || cy < 0 || cy >= MINIMAP_ROWS) return false;
+    int64_t centerX = ((int64_t)cx << minimapScale) + ((int64_t)1 << minimapScale) / 2;
+    int64_t centerY = ((int64_t)cy << (minimapScale + 1)) + ((int64_t)1 << minimapScale);
+    MoveCamera(centerX - viewCols / 2, centerY - viewRows / 2);
+    return true;
+}
+
+// ================= 翻开、双击与结束 =================
+
+// 标题栏下一行的结束提示：先把整行擦成底色，不留上一条提示的残字
+static void ShowBanner(const char* text, int color) {
+    cgt_fill_span(1, 2, VIEW_X + viewCols * layout->pitchX, COLOR_BLACK, COLOR_BLACK);
+    cgt_print_str(text, 1, 2, color, COLOR_BLACK);
+}
+
+// 踩到的雷画在视口第 r 行第 c 列；提示和音效不论雷在不在视口里都有
+static void ShowExplosion(int r, int c) {
+    play_bomb_sound();
+    if (r >= 0 && r < viewRows && c >= 0 && c < viewCols) PaintSprite(r, c, SPRITE_EXPLODED);
+    char buf[128];
+    snprintf(buf, sizeof(buf), "游戏结束！你踩到雷了！共翻开 %lld 格。按任意键退出。", (long long)*view->revealedCount);
+    ShowBanner(buf, COLOR_RED);
+}
+
+// 双击已翻开的数字：周围旗数等于数字时翻开其余邻格，踩到雷时返回该雷的坐标
+static bool ViewChord(int64_t x, int64_t y, WorldPos& hit) {
+    uint8_t cell = view->cell(x, y);
+    if (!cellIsRevealed(cell)) return false;
+
+    int flagCount = 0;
+    for (int k = 0; k < 8; k++) {
+        int64_t nx = x + NEIGHBOURS[k].dc, ny = y + NEIGHBOURS[k].dr;
+        if (InBoard(nx, ny)) flagCount += cellIsFlagged(view->cell(nx, ny));
+    }
+    if (flagCount != cellCount(cell)) return false;
+
+    for (int k = 0; k < 8; k++) {
+        int64_t nx = x + NEIGHBOURS[k].dc, ny = y + NEIGHBOURS[k].dr;
+        if (!InBoard(nx, ny)) continue;
+        uint8_t target = view->cell(nx, ny);
+        if (cellIsFlagged(target) || cellIsRevealed(target)) continue;
+        if (cellIsMine(target)) {
+            hit.x = nx;
+            hit.y = ny;
+            return true;
+        }
+        view->reveal(nx, ny, viewRevealed, viewUnflagged);
+    }
+    return false;
+}
+
+// 踩到 (x, y) 上的雷：最后翻开的格子和爆炸画在同一帧里，等按键之前先结束这一帧
+static void ViewGameOver(int64_t x, int64_t y) {
+    cgt_begin_frame();
+    PaintViewRevealed();
+    // 双击视口边上的数字可能踩到视口外的雷：先把视口移到以它为中心
+    if (y < viewCameraY || y >= viewCameraY + viewRows || x < viewCameraX || x >= viewCameraX + viewCols) {
+        MoveCamera(x - viewCols / 2, y - viewRows / 2);
+    }
+    ShowExplosion((int)(y - viewCameraY), (int)(x - viewCameraX));
+    cgt_end_frame();
+    wait_for_enter();
+}
+
+static void ViewWin() {
+    play_victory_sound();
+    char buf[192];
+    if (view->formatWin) {
+        view->formatWin(buf, sizeof(buf));
+    } else {
+        snprintf(buf, sizeof(buf), "游戏结束！你成功清除所有雷！按任意键退出。");
+    }
+    ShowBanner(buf, COLOR_GREEN);
+    wait_for_enter();
+}
+
+static void RunViewLoop() {
+    while (cgt_has_mouse()) {
+        int x, y, button, event;
+        cgt_get_mouse(x, y, button, event);
+    }
+    bool FirstClick = view->firstClick != NULL;
+
+    while (true) {
+        DrawTitle();
+
+        if (cgt_has_key()) {
+            char key;
+            cgt_get_key(key);
+            int64_t dx = 0, dy = 0;
+            switch (key) {
+                case 'w': case 'W': dy = -VIEW_STEP; break;
+                case 's': case 'S': dy = VIEW_STEP; break;
+                case 'a': case 'A': dx = -VIEW_STEP; break;
+                case 'd': case 'D': dx = VIEW_STEP; break;
+                case 'q': case 'Q': return;
+                default: break;
+            }
+            if (dx != 0 || dy != 0) MoveCamera(viewCameraX + dx, viewCameraY + dy);
+            continue;
+        }
+
+        if (!cgt_has_mouse()) {
+            cgt_msleep(50);
+            continue;
+        }
+
+        int x, y, button, event;
+        cgt_get_mouse(x, y, button, event);
+        // Windows 上移动事件不带按键，拖动状态自己记
+        if (event == MOUSE_CLICK && button == MOUSE_BUTTON_MIDDLE) {
+            dragging = true;
+            dragX = x;
+            dragY = y;
+            continue;
+        }
+        if (event == MOUSE_RELEASE) dragging = false;
+        if (dragging && event == MOUSE_MOVE) {
+            DragCamera(x, y);
+            continue;
+        }
+        if (event == MOUSE_CLICK && button == MOUSE_BUTTON_LEFT && MinimapJump(x, y)) continue;
+
+        int r, c;
+        bool onCell = ViewCellAt(x, y, r, c) && InBoard(viewCameraX + c, viewCameraY + r);
+        UpdateHover(onCell ? r : -1, onCell ? c : -1);
+        if (!onCell) continue;
+        int64_t wx = viewCameraX + c;
+        int64_t wy = viewCameraY + r;
+
+        if (event == MOUSE_CLICK && FirstClick) {
+            view->firstClick(wx, wy);
+            FirstClick = false;
+        }
+
+        if (event == MOUSE_CLICK && button == MOUSE_BUTTON_LEFT) {
+            // 插了旗的格子照样翻开，与改版前一致：旗下是雷就踩雷，不是雷就收回旗
+            uint8_t cell = view->cell(wx, wy);
+            if (cellIsRevealed(cell)) continue;
+            if (cellIsMine(cell)) {
+                ViewGameOver(wx, wy);
+                return;
+            }
+            // 一次翻开一大片时整片一起出现
+            cgt_begin_frame();
+            view->reveal(wx, wy, viewRevealed, viewUnflagged);
+            PaintViewRevealed();
+            cgt_end_frame();
+        } else if (event == MOUSE_CLICK && button == MOUSE_BUTTON_RIGHT) {
+            cgt_begin_frame();
+            bool wasFlagged = cellIsFlagged(view->peek(wx, wy));
+            bool flagged = view->toggleFlag(wx, wy);
+            PaintViewCell(r, c);
+            if (flagged != wasFlagged) UpdateMinimapFlag(wx, wy, flagged ? 1 : -1);
+            cgt_end_frame();
+        } else if (event == MOUSE_DOUBLECLICK && button == MOUSE_BUTTON_LEFT) {
+            WorldPos hit;
+            cgt_begin_frame();
+            bool boom = ViewChord(wx, wy, hit);
+            if (!boom) PaintViewRevealed();
+            cgt_end_frame();
+            if (boom) {
+                ViewGameOver(hit.x, hit.y);
+                return;
+            }
+        } else {
+            continue;
+        }
+        if (view->settle) view->settle();
+        hudDirty = true;
+
+        if (view->won && view->won()) {
+            ViewWin();
+            return;
+        }
+    }
+}
+
+void viewRun(const ViewBoard& board) {
+    view = &board;
+    layout = viewCompact ? &LAYOUT_COMPACT : &LAYOUT_NORMAL;
+    BuildSprites();
+    viewRows = board.rows > 0 ? (int)min(board.rows, (int64_t)layout->rows) : layout->rows;
+    viewCols = board.cols > 0 ? (int)min(board.cols, (int64_t)layout->cols) : layout->cols;
+    hoverR = -1;
+    hoverC = -1;
+    dragging = false;
+    hudText[0] = '\0';
+    hudDirty = true;
+    ClampCamera();
+    MinimapSetup();
+    cgt_clear_screen();
+    cgt_begin_frame();
+    DrawView();
+    // 整块棋盘都在视口里时不提示移动
+    if (minimapScale >= 0 || board.rows <= 0 || board.cols <= 0) {
+        cgt_print_str("WASD / 中键拖动 / 点小地图 移动视口 , 左键翻开 , 右键插旗 , 双击数字翻开周围 , Q 返回菜单",
+                      1, VIEW_Y + viewRows * layout->pitchY + 2, COLOR_LIGHT_BLUE, COLOR_BLACK);
+    }
+    cgt_end_frame();
+    RunViewLoop();
+    viewRevealed.clear();
+    viewUnflagged.clear();
+    countTreeRelease(minimapTree);
+    view = NULL;
+}
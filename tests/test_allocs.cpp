@@ -0,0 +1,91 @@
+// 直接包含 game.cpp，测试才能调用其中的 static 函数；链接时不再需要 game.o
+#include "../src/game.cpp"
+#include <chrono>
+#include <thread>
+
+// game.cpp 引用的全局变量（定义在 main.cpp）
+int rows, cols, mineCount;
+bool SafeZone = true;
+uint64_t gameSeed = 0;
+
+// ================= 连续对局不再分配堆内存 =================
+// arena.cpp 以 MINESWEEPER_COUNT_ALLOCS 编译（见 Makefile），全局 operator new 计数。
+// 按 Game() 的顺序开局、首次点击、翻开、插旗，只是不进入视口；
+// 每种尺寸先热身几局，之后的对局（一半取自后台池，一半指定种子）分配次数必须为 0。
+
+static vector<WorldPos> opened;     // 代替视口的翻开列表，跨操作复用
+static vector<WorldPos> unflagged;  // 代替视口的收回旗列表
+
+// 依次翻开 / 插旗 count 个还没翻开的格子：非雷翻开，雷插旗
+static void PlayCells(int count, uint64_t seed) {
+    BoardRng rng;
+    rngInit(rng, seed, rows, cols, totalMines, 2);
+    for (int k = 0; k < count; k++) {
+        int64_t x = rngBelow(rng, (uint32_t)cols), y = rngBelow(rng, (uint32_t)rows);
+        uint8_t cell = DenseCell(x, y);
+        if (cellIsRevealed(cell) || cellIsFlagged(cell)) continue;
+        if (cellIsMine(cell)) {
+            DenseToggleFlag(x, y);
+        } else {
+            DenseReveal(x, y, opened, unflagged);
+        }
+    }
+}
+
+static void PlayGame(int R, int C, int M, uint64_t seed) {
+    rows = R;
+    cols = C;
+    mineCount = M;
+    gameSeed = seed;
+
+    totalMines = mineCount;
+    PrepareBoard();
+    openingIndexBuild(openings, cells, rows, cols);
+    FormatTitle();
+    revealedCells = 0;
+    flagsOnMines = 0;
+
+    char title[192];
+    DenseFirstClick(C / 2, R / 2);
+    DenseReveal(C / 2, R / 2, opened, unflagged);
+    PlayCells(40, seed + 1);
+    DenseTitle(title, sizeof(title));
+    DenseWon();
+    opened.clear();
+    unflagged.clear();
+
+    // cleanupGame 会清屏，这里只交还格子数组
+    cells = NULL;
+}
+
+int main() {
+    struct Size { int rows, cols, mines; };
+    const Size sizes[] = { {6, 6, 6}, {9, 16, 20}, {12, 30, 80}, {40, 70, 500}, {100, 100, 2000} };
+
+    // 视口的列表归视口管理，这里按最大的棋盘预留一次，只统计引擎里的分配
+    opened.reserve(100 * 100);
+    unflagged.reserve(100 * 100);
+
+    bool ok = true;
+    for (const Size& s : sizes) {
+        for (int i = 0; i < 20; i++) {
+            PlayGame(s.rows, s.cols, s.mines, (i % 2) ? 0 : (uint64_t)i + 1);
+            this_thread::sleep_for(chrono::milliseconds(2));
+        }
+        // 等后台池把这个尺寸的棋盘备齐，之后取板不会再等待生成
+        this_thread::sleep_for(chrono::milliseconds(100));
+
+        size_t before = allocationCount();
+        for (int i = 0; i < 500; i++) {
+            PlayGame(s.rows, s.cols, s.mines, (i % 2) ? 0 : (uint64_t)i + 1000);
+            this_thread::sleep_for(chrono::microseconds(200));
+        }
+        size_t allocations = allocationCount() - before;
+        printf("%dx%d, %d mines: 500 games after warm-up, %zu heap allocations\n", s.rows, s.cols, s.mines, allocations);
+        ok = ok && allocations == 0;
+    }
+
+    boardPoolShutdown();
+    releaseGameBuffers();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "bitboard.h"
+
+using namespace std;
+
+// ================= bitboardRowCounts 与逐格计数比对 =================
+// 同一份源码分别以默认选项、标量、AVX2 编译（见 Makefile），每个版本都必须与
+// 带边界检查的 3x3 求和逐格一致。列数特意覆盖 64 位字边界前后，边缘列单独布满雷。
+
+#if defined(__AVX2__)
+  #define TEST_PATH "avx2"
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define TEST_PATH "sse2"
+#else
+  #define TEST_PATH "scalar"
+#endif
+
+// 3x3 范围内（含自身）的雷数，超出棋盘的格子不算
+static int naiveCount(const vector<char>& mines, int rows, int cols, int r, int c) {
+    int n = 0;
+    for (int dr = -1; dr <= 1; dr++) {
+        for (int dc = -1; dc <= 1; dc++) {
+            int nr = r + dr, nc = c + dc;
+            if (nr < 0 || nr >= rows || nc < 0 || nc >= cols) continue;
+            n += mines[nr * cols + nc];
+        }
+    }
+    return n;
+}
+
+// 按密度 density (0~100) 随机布雷；edges 为 true 时第一列和最后一列全部布雷
+static int checkBoard(mt19937& rng, int rows, int cols, int density, bool edges) {
+    vector<char> mines((size_t)rows * cols);
+    Bitboard bb;
+    bitboardInit(bb, rows, cols);
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            bool mine = (int)(rng() % 100) < density || (edges && (c == 0 || c == cols - 1));
+            mines[r * cols + c] = mine;
+            if (mine) bitboardSet(bb, r, c);
+        }
+    }
+
+    int mismatches = 0;
+    vector<uint8_t> out(cols);
+    for (int r = 0; r < rows; r++) {
+        bitboardRowCounts(bb, r, out.data());
+        for (int c = 0; c < cols; c++) {
+            int expected = naiveCount(mines, rows, cols, r, c);
+            if (out[c] != expected) {
+                if (mismatches == 0) {
+                    printf("  %dx%d density %d%%: (%d, %d) got %d, expected %d\n",
+                           rows, cols, density, r, c, out[c], expected);
+                }
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+int main() {
+    mt19937 rng(2024);
+    const int edgeCols[] = { 1, 2, 3, 62, 63, 64, 65, 66, 127, 128, 129, 191, 192, 193, 255, 256, 257, 300 };
+    const int densities[] = { 0, 5, 20, 50, 80, 100 };
+
+    int boards = 0, mismatches = 0;
+    for (int cols : edgeCols) {
+        for (int rows : { 1, 2, 3, 17 }) {
+            for (int density : densities) {
+                mismatches += checkBoard(rng, rows, cols, density, false);
+                mismatches += checkBoard(rng, rows, cols, density, true);
+                boards += 2;
+            }
+        }
+    }
+    for (int k = 0; k < 2000; k++) {
+        int rows = 1 + (int)(rng() % 70), cols = 1 + (int)(rng() % 300);
+        mismatches += checkBoard(rng, rows, cols, (int)(rng() % 101), rng() % 4 == 0);
+        boards++;
+    }
+
+    printf("bitboard (%s): %d boards, %d mismatches\n", TEST_PATH, boards, mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+#include "game.h"
+
+using namespace std;
+
+// game.cpp 引用的全局变量（定义在 main.cpp）
+int rows, cols, mineCount;
+bool SafeZone;
+uint64_t gameSeed;
+
+// ================= relocateMines 的均匀性 =================
+// 先不带安全区布雷，再在首次点击处 relocateMines。统计每种雷分布出现的次数，
+// 与“满足安全区的所有分布等概率”做卡方检验。种子固定，结果可复现。
+
+// 雷数正确、每个非雷格子的周围雷数正确
+static bool countsValid(const uint8_t* cells, int R, int C, int M) {
+    int stride = boardStride(C), mines = 0;
+    for (int i = 0; i < R; i++) {
+        for (int j = 0; j < C; j++) {
+            int idx = boardIndex(i, j, stride);
+            if (cellIsMine(cells[idx])) {
+                if (cells[idx] != CELL_MINE) return false;
+                mines++;
+                continue;
+            }
+            int n = 0;
+            for (int k = 0; k < 8; k++) n += cellIsMine(cells[idx + neighbourOffset(k, stride)]);
+            if (cellCount(cells[idx]) != n) return false;
+        }
+    }
+    return mines == M;
+}
+
+// 返回是否通过；|z| 超过 Z_LIMIT 视为不均匀
+#define Z_LIMIT 4.0
+
+static bool checkUniform(int R, int C, int M, int r, int c, int trials) {
+    vector<uint8_t> board(boardCellCount(R, C));
+    map<vector<int>, int> seen;
+    int stride = boardStride(C);
+    bool valid = true;
+
+    for (int t = 1; t <= trials; t++) {
+        generateMines(-1, -1, R, C, M, board.data(), false, t);
+        relocateMines(r, c, R, C, M, board.data(), true, t);
+        valid = valid && countsValid(board.data(), R, C, M) && boardFitsFirstClick(board.data(), r, c, R, C, M, true);
+
+        vector<int> key;
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++)
+                if (cellIsMine(board[boardIndex(i, j, stride)])) key.push_back(i * C + j);
+        seen[key]++;
+    }
+
+    // 区外空格数为 freeCells，合法分布共 C(freeCells, M) 种
+    int radius = safeZoneRadius(r, c, R, C, M, true);
+    int zone = 0;
+    for (int i = 0; i < R; i++)
+        for (int j = 0; j < C; j++)
+            if (abs(i - r) <= radius && abs(j - c) <= radius) zone++;
+    int freeCells = R * C - zone;
+    double configs = 1;
+    for (int k = 0; k < M; k++) configs = configs * (freeCells - k) / (k + 1);
+
+    double expected = trials / configs, chi = 0;
+    for (auto& kv : seen) chi += (kv.second - expected) * (kv.second - expected) / expected;
+    chi += (configs - seen.size()) * expected;
+    double df = configs - 1;
+    double z = (chi - df) / sqrt(2 * df);
+
+    bool ok = valid && seen.size() == (size_t)configs && fabs(z) < Z_LIMIT;
+    printf("%dx%d, %d mines, click (%d, %d), radius %d: %zu/%.0f sets, chi2 %.1f, z %.2f%s%s\n",
+           R, C, M, r, c, radius, seen.size(), configs, chi, z,
+           valid ? "" : ", INVALID BOARD", ok ? "" : "  FAILED");
+    return ok;
+}
+
+int main() {
+    bool ok = true;
+    ok &= checkUniform(4, 4, 5, 1, 1, 100000);    // 3x3 安全区，21 种
+    ok &= checkUniform(4, 4, 13, 1, 1, 100000);   // 雷太多，退回只保护点击格，105 种
+    ok &= checkUniform(4, 5, 6, 2, 3, 100000);    // 安全区贴边，462 种
+    ok &= checkUniform(6, 6, 33, 2, 2, 100000);   // 区外只剩 3 个空格，595 种
+    ok &= checkUniform(10, 10, 98, 5, 5, 100000); // 区外只剩 2 个空格，约四分之一 64 次未中、走线性扫描，99 种
+    return ok ? 0 : 1;
+}
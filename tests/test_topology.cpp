@@ -0,0 +1,159 @@
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <set>
+#include <vector>
+#include "board_fixed.h"
+#include "game.h"
+#include "reveal.h"
+#include "topology.h"
+
+using namespace std;
+
+// game.cpp 引用的全局变量（定义在 main.cpp）
+int rows, cols, mineCount;
+bool SafeZone;
+uint64_t gameSeed;
+
+// ================= 按拓扑模板化的内核 =================
+// 方格：topologyGenerateMines / topologyReveal 必须与 generateMines / revealFlood 逐字节相同。
+// 环面、六边形、CSR 任意图：没有现成的对照，检查布雷结果自洽——
+// 雷数正确、每个非雷格子的计数等于邻格里的雷数、安全区里没有雷，
+// 展开只翻开非雷格子，且翻开的 0 雷格子的邻格全部翻开。
+
+static int failures = 0;
+
+static void Expect(bool ok, const char* what, int a, int b) {
+    if (ok) return;
+    if (failures < 10) printf("  FAILED: %s (%d, %d)\n", what, a, b);
+    failures++;
+}
+
+// ----- 方格：与现有路径比对 -----
+
+template <class Geometry>
+static void CheckSquare(const Geometry& g, int mines, int seeds, mt19937& rng) {
+    SquareTopology<Geometry> t = {g};
+    const int R = g.rows(), C = g.cols();
+    vector<uint8_t> expected(g.cellCount()), actual(g.cellCount());
+    vector<int> candidates((size_t)R * C);
+    vector<int> a, b;
+
+    for (int s = 1; s <= seeds; s++) {
+        // 一半带首次点击安全区，一半不带
+        bool zone = s % 2 == 0;
+        int r = zone ? (int)(rng() % R) : -1, c = zone ? (int)(rng() % C) : -1;
+        int start = zone ? boardIndex(r, c, g.stride()) : -1;
+
+        generateMines(r, c, R, C, mines, expected.data(), zone, s);
+        topologyGenerateMines(t, start, mines, zone, s, actual.data(), candidates.data());
+        Expect(expected == actual, "square board differs from generateMines", R * 1000 + C, s);
+
+        int click = boardIndex((int)(rng() % R), (int)(rng() % C), g.stride());
+        a.clear();
+        b.clear();
+        int na = revealFlood(expected.data(), g.stride(), click, a);
+        int nb = topologyReveal(t, actual.data(), click, b);
+        Expect(na == nb && a == b && expected == actual, "square reveal differs from revealFlood", R * 1000 + C, s);
+    }
+}
+
+// ----- 其他拓扑：自洽性 -----
+
+template <class Topology>
+static void CheckConsistent(const char* name, const Topology& t, int mines, int seeds, mt19937& rng) {
+    vector<uint8_t> cells(t.cellCount());
+    vector<int> candidates(t.nodeCount());
+    vector<int> revealed;
+    int boards = 0;
+
+    for (int s = 1; s <= seeds; s++) {
+        int start = t.node((int)(rng() % t.nodeCount()));
+        topologyGenerateMines(t, start, mines, true, s, cells.data(), candidates.data());
+        int radius = topologySafeZoneRadius(t, cells.data(), start, mines, true);
+
+        int mineTotal = 0;
+        for (int i = 0; i < t.nodeCount(); i++) {
+            int idx = t.node(i);
+            uint8_t cell = cells[idx];
+            if (cellIsMine(cell)) {
+                Expect(cell == CELL_MINE, "mine cell carries other bits", i, s);
+                mineTotal++;
+                continue;
+            }
+            int n = 0;
+            t.forEachNeighbour(idx, [&](int m) { n += cellIsMine(cells[m]); });
+            Expect(cellCount(cell) == n, "count differs from neighbouring mines", i, s);
+        }
+        Expect(mineTotal == mines, "wrong number of mines", mineTotal, mines);
+        if (radius >= 0) Expect(!cellIsMine(cells[start]), "mine on the first click", start, s);
+        if (radius >= 1) {
+            t.forEachNeighbour(start, [&](int m) { Expect(!cellIsMine(cells[m]), "mine next to the first click", m, s); });
+        }
+
+        revealed.clear();
+        int n = topologyReveal(t, cells.data(), start, revealed);
+        Expect(n == (int)revealed.size(), "reveal count differs from list", n, (int)revealed.size());
+        for (size_t k = 0; k < revealed.size(); k++) {
+            uint8_t cell = cells[revealed[k]];
+            Expect(!cellIsMine(cell) && cellIsRevealed(cell), "reveal opened a mine", revealed[k], s);
+            if (cellCount(cell) != 0) continue;
+            t.forEachNeighbour(revealed[k], [&](int m) {
+                Expect(cellIsRevealed(cells[m]), "zero cell left a hidden neighbour", m, s);
+            });
+        }
+        boards++;
+    }
+    printf("%s, %d mines: %d boards checked\n", name, mines, boards);
+}
+
+// 随机无向图：无重边、无自环，每个结点至多 maxDegree 个邻居，邻接表转成 CSR
+static void BuildGraph(int nodes, int maxDegree, mt19937& rng, vector<int>& starts, vector<int>& targets) {
+    vector<set<int> > adjacent(nodes);
+    for (int e = 0; e < nodes * maxDegree; e++) {
+        int a = (int)(rng() % nodes), b = (int)(rng() % nodes);
+        if (a == b || adjacent[a].count(b)) continue;
+        if ((int)adjacent[a].size() >= maxDegree || (int)adjacent[b].size() >= maxDegree) continue;
+        adjacent[a].insert(b);
+        adjacent[b].insert(a);
+    }
+    starts.assign(1, 0);
+    targets.clear();
+    for (int i = 0; i < nodes; i++) {
+        targets.insert(targets.end(), adjacent[i].begin(), adjacent[i].end());
+        starts.push_back((int)targets.size());
+    }
+}
+
+int main() {
+    mt19937 rng(17);
+
+    // 方格：运行期尺寸（含 1 行 / 1 列、跨 64 位字）与三个预设尺寸
+    const int shapes[][3] = { {1, 1, 0}, {1, 7, 3}, {7, 1, 2}, {9, 9, 10}, {16, 30, 99}, {33, 65, 400}, {20, 20, 390} };
+    for (const auto& s : shapes) {
+        DynamicGeometry g = {s[0], s[1]};
+        CheckSquare(g, s[2], 40, rng);
+    }
+    CheckSquare(FixedGeometry<6, 6>(), 6, 40, rng);
+    CheckSquare(FixedGeometry<9, 16>(), 20, 40, rng);
+    CheckSquare(FixedGeometry<12, 30>(), 80, 40, rng);
+    printf("square: generateMines / revealFlood equivalence checked\n");
+
+    TorusTopology torus = {20, 30};
+    CheckConsistent("torus 20x30", torus, 100, 200, rng);
+    CheckConsistent("torus 3x3", TorusTopology{3, 3}, 4, 200, rng);
+    CheckConsistent("torus 20x30 dense", torus, 450, 200, rng);
+
+    HexTopology<DynamicGeometry> hex = {{15, 20}};
+    CheckConsistent("hex 15x20", hex, 60, 200, rng);
+    CheckConsistent("hex 15x20 dense", hex, 250, 200, rng);
+
+    vector<int> starts, targets;
+    BuildGraph(500, 15, rng, starts, targets);
+    GraphTopology graph = {500, starts.data(), targets.data()};
+    CheckConsistent("graph 500 nodes", graph, 80, 200, rng);
+    CheckConsistent("graph 500 nodes dense", graph, 400, 200, rng);
+
+    printf("topology: %d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}